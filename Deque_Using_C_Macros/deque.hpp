@@ -3,23 +3,488 @@
 
 #include <cstring>
 #include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+#include <climits>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <sys/uio.h>
 
-#define LIST_CAPACITY 20
+#define LIST_CAPACITY 32 /* Must be a power of two */
 #define BEGIN_INDEX 0
 #define DOUBLE 2
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_SORT_THRESHOLD 64 /* Buckets smaller than this are finished by std::sort */
+#define PARALLEL_SORT_MIN_ELEMENTS 65536 /* Smaller ranges are sorted by the calling thread */
+
+/*
+ * Growth policy of Deque (capacity always stays a power of two)
+ * The default policy doubles the capacity and never shrinks automatically.
+ */
+struct DequeGrowthPolicy {
+    size_t growth_factor; // Capacity is multiplied by it when Deque is full (rounded up to a power of two)
+    size_t max_factor_capacity; // From this capacity on growth falls back to doubling (0 means no limit)
+    size_t shrink_divisor; // Pops shrink the buffer once size drops below capacity / shrink_divisor (0 means never, at least 4)
+    size_t min_capacity; // Shrinking never goes below this capacity (rounded up to a power of two, at least LIST_CAPACITY)
+};
+
+// Smallest power of two capacity which can hold count elements (never below LIST_CAPACITY)
+inline size_t deque_power_of_two_capacity(size_t count) {
+    size_t capacity = LIST_CAPACITY;
+    while (capacity < count) {
+        capacity *= DOUBLE;
+    }
+    return capacity;
+}
+
+/*
+ * Helpers for the uninitialized buffer of Deque
+ * Only slots holding elements are constructed, trivially copyable elements are copied and moved with memcpy.
+ */
+template<typename T>
+inline T *deque_allocate(size_t capacity) {
+    return std::allocator<T>().allocate(capacity);
+}
+
+template<typename T>
+inline void deque_deallocate(T *list, size_t capacity) {
+    std::allocator<T>().deallocate(list, capacity);
+}
+
+// Destroy count elements starting at first
+template<typename T>
+inline void deque_destroy(T *first, size_t count) {
+    if (!std::is_trivially_destructible<T>::value) {
+        for (size_t i = 0; i < count; i++) {
+            first[i].~T();
+        }
+    }
+}
+
+// Copy construct count elements of src into uninitialized dst
+template<typename T>
+inline void deque_construct_copies(T *dst, const T *src, size_t count) {
+    if (std::is_trivially_copyable<T>::value) {
+        memcpy((void *) dst, (const void *) src, count * sizeof(T));
+    } else {
+        std::uninitialized_copy(src, src + count, dst);
+    }
+}
+
+// Move count elements of src into uninitialized dst, src is left uninitialized
+template<typename T>
+inline void deque_relocate(T *dst, T *src, size_t count) {
+    if (std::is_trivially_copyable<T>::value) {
+        memcpy((void *) dst, (const void *) src, count * sizeof(T));
+    } else {
+        std::uninitialized_copy(std::make_move_iterator(src), std::make_move_iterator(src + count), dst);
+        deque_destroy(src, count);
+    }
+}
+
+// Move count elements of src to lower address dst one by one, ranges may overlap (a slot is reused once it is vacated)
+template<typename T>
+inline void deque_relocate_down(T *dst, T *src, size_t count) {
+    if (std::is_trivially_copyable<T>::value) {
+        memmove((void *) dst, (const void *) src, count * sizeof(T));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+/*
+ * Inline storage for the first N elements of a small Deque (no storage when N is 0)
+ */
+template<typename T, size_t N>
+struct DequeInlineBuffer {
+    alignas(T) unsigned char storage[N * sizeof(T)];
+
+    T *data() { return reinterpret_cast<T *>(storage); }
+};
+
+template<typename T>
+struct DequeInlineBuffer<T, 0> {
+    T *data() { return nullptr; }
+};
+
+/*
+ * Random access iterator over a range of a power of two ring buffer
+ * Element at index i is stored at list[(front + i) & mask], which lets std algorithms work on the ring in place.
+ */
+template<typename T>
+class DequeRingIterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T *pointer;
+    typedef T &reference;
+
+    DequeRingIterator() : _list{nullptr}, _front{0}, _mask{0}, _index{0} {}
+    DequeRingIterator(T *list, size_t front, size_t mask, size_t index) : _list{list}, _front{front}, _mask{mask}, _index{index} {}
+
+    reference operator*() const { return _list[(_front + _index) & _mask]; }
+    pointer operator->() const { return &_list[(_front + _index) & _mask]; }
+    reference operator[](difference_type offset) const { return _list[(_front + _index + offset) & _mask]; }
+
+    DequeRingIterator &operator++() { ++_index; return *this; }
+    DequeRingIterator operator++(int) { DequeRingIterator old_iter(*this); ++_index; return old_iter; }
+    DequeRingIterator &operator--() { --_index; return *this; }
+    DequeRingIterator operator--(int) { DequeRingIterator old_iter(*this); --_index; return old_iter; }
+    DequeRingIterator &operator+=(difference_type offset) { _index += offset; return *this; }
+    DequeRingIterator &operator-=(difference_type offset) { _index -= offset; return *this; }
+    DequeRingIterator operator+(difference_type offset) const { return DequeRingIterator(_list, _front, _mask, _index + offset); }
+    DequeRingIterator operator-(difference_type offset) const { return DequeRingIterator(_list, _front, _mask, _index - offset); }
+    friend DequeRingIterator operator+(difference_type offset, const DequeRingIterator &iter) { return iter + offset; }
+    difference_type operator-(const DequeRingIterator &iter) const { return (difference_type) (_index - iter._index); }
+
+    bool operator==(const DequeRingIterator &iter) const { return _index == iter._index; }
+    bool operator!=(const DequeRingIterator &iter) const { return _index != iter._index; }
+    bool operator<(const DequeRingIterator &iter) const { return _index < iter._index; }
+    bool operator>(const DequeRingIterator &iter) const { return _index > iter._index; }
+    bool operator<=(const DequeRingIterator &iter) const { return _index <= iter._index; }
+    bool operator>=(const DequeRingIterator &iter) const { return _index >= iter._index; }
+
+private:
+    T *_list;
+    size_t _front;
+    size_t _mask;
+    size_t _index;
+};
+
+/*
+ * Types accepted by the radix sort (integral types except bool)
+ */
+template<typename T>
+struct deque_radix_sortable : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value> {};
+
+// Digit of value used by radix sort pass at shift, sign bit is flipped so negative values come first
+template<typename T>
+inline size_t deque_radix_digit(T value, int shift) {
+    typedef typename std::make_unsigned<T>::type U;
+    const U sign_flip = std::is_signed<T>::value ? (U) ((U) 1 << (sizeof(T) * CHAR_BIT - 1)) : (U) 0;
+    return (size_t) ((((U) value) ^ sign_flip) >> shift) & (RADIX_BUCKETS - 1);
+}
+
+/*
+ * In place MSD radix sort (American flag sort) of integral values in ascending order
+ * Every pass counts digits, then swaps each element directly into its bucket, so no extra buffer is needed.
+ */
+template<typename Iter>
+void deque_radix_sort(Iter first, Iter last, int shift) {
+    typedef typename std::iterator_traits<Iter>::value_type T;
+    size_t count = (size_t) (last - first);
+    if (count < RADIX_SORT_THRESHOLD) {
+        std::sort(first, last);
+        return;
+    }
+    size_t bucket_heads[RADIX_BUCKETS], bucket_tails[RADIX_BUCKETS] = {0};
+    for (Iter iter = first; iter != last; ++iter) {
+        bucket_tails[deque_radix_digit(*iter, shift)]++;
+    }
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+        bucket_heads[bucket] = offset;
+        offset += bucket_tails[bucket];
+        bucket_tails[bucket] = offset;
+    }
+    size_t bucket_starts[RADIX_BUCKETS];
+    std::copy(bucket_heads, bucket_heads + RADIX_BUCKETS, bucket_starts);
+    // Cycle elements into their buckets
+    for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+        while (bucket_heads[bucket] < bucket_tails[bucket]) {
+            T value = first[bucket_heads[bucket]];
+            size_t digit = deque_radix_digit(value, shift);
+            while (digit != bucket) {
+                std::swap(value, first[bucket_heads[digit]++]);
+                digit = deque_radix_digit(value, shift);
+            }
+            first[bucket_heads[bucket]++] = value;
+        }
+    }
+    if (shift == 0) {
+        return;
+    }
+    for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+        deque_radix_sort(first + bucket_starts[bucket], first + bucket_tails[bucket], shift - RADIX_BITS);
+    }
+}
+
+/*
+ * Radix sort of integral values, compare is still the order of the result
+ * A compare that orders 1 before 0 (descending) is sorted with compare directly, any other order that the ascending
+ * radix result does not satisfy is sorted again with compare.
+ */
+template<typename Iter, typename Compare>
+void deque_radix_sort(Iter first, Iter last, Compare compare, std::true_type) {
+    typedef typename std::iterator_traits<Iter>::value_type T;
+    const T zero = 0, one = 1;
+    if (compare(one, zero)) {
+        std::sort(first, last, compare);
+        return;
+    }
+    deque_radix_sort(first, last, (int) (sizeof(T) * CHAR_BIT) - RADIX_BITS);
+    if (!std::is_sorted(first, last, compare)) {
+        std::sort(first, last, compare);
+    }
+}
+
+// Types without radix digits are sorted with the compare function
+template<typename Iter, typename Compare>
+void deque_radix_sort(Iter first, Iter last, Compare compare, std::false_type) {
+    std::sort(first, last, compare);
+}
+
+// Number of elements taken from run 1 among the first k elements of the stable merge of run 1 and run 2 (co-rank)
+template<typename T, typename Compare>
+size_t deque_merge_corank(size_t k, const T *first1, size_t count1, const T *first2, size_t count2, Compare &compare) {
+    size_t low = (k > count2) ? k - count2 : 0, high = std::min(k, count1);
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        // Enough elements of run 1 are taken once the last taken element of run 2 precedes the next one of run 1
+        if (compare(first2[k - mid - 1], first1[mid])) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+// Stable merge of two sorted runs moving their elements into uninitialized dst
+// If compare or a move constructor throws, elements already built in dst are destroyed (sources stay moved-from)
+template<typename T, typename Compare>
+void deque_merge_relocate(T *first1, T *last1, T *first2, T *last2, T *dst, Compare &compare) {
+    T *dst_begin = dst;
+    try {
+        while (first1 != last1 && first2 != last2) {
+            if (compare(*first2, *first1)) {
+                new (dst) T(std::move(*first2++));
+            } else {
+                new (dst) T(std::move(*first1++));
+            }
+            dst++;
+        }
+        for (; first1 != last1; dst++) {
+            new (dst) T(std::move(*first1++));
+        }
+        for (; first2 != last2; dst++) {
+            new (dst) T(std::move(*first2++));
+        }
+    } catch (...) {
+        deque_destroy(dst_begin, (size_t) (dst - dst_begin));
+        throw;
+    }
+}
+
+/*
+ * Merge of sorted runs [first, middle) and [middle, last) by parts threads
+ * Output is split into equal parts whose inputs are found by co-ranking (on the calling thread, before any element
+ * is moved), every thread merges its part into a buffer and after all parts are merged moves it back.
+ * Falls back to std::inplace_merge for one part, small ranges, types whose move constructor may throw
+ * (an exception cannot leave a worker thread) or when the buffer cannot be allocated.
+ */
+template<typename T, typename Compare>
+void deque_parallel_merge(T *first, T *middle, T *last, Compare &compare, unsigned parts) {
+    size_t count = (size_t) (last - first), count1 = (size_t) (middle - first), count2 = (size_t) (last - middle);
+    T *buffer = nullptr;
+    if (parts > 1 && count >= PARALLEL_SORT_MIN_ELEMENTS && std::is_nothrow_move_constructible<T>::value) {
+        try {
+            buffer = deque_allocate<T>(count);
+        } catch (const std::bad_alloc &) {
+            buffer = nullptr;
+        }
+    }
+    if (buffer == nullptr) {
+        std::inplace_merge(first, middle, last, compare);
+        return;
+    }
+
+    // Split points are searched before workers start moving elements out of the runs
+    std::vector<size_t> taken(parts + 1);
+    for (unsigned part = 0; part <= parts; part++) {
+        taken[part] = deque_merge_corank(count * part / parts, first, count1, middle, count2, compare);
+    }
+    std::vector<std::thread> workers;
+    for (unsigned part = 0; part < parts; part++) {
+        workers.emplace_back([=, &taken, &compare]() {
+            size_t out_begin = count * part / parts, out_end = count * (part + 1) / parts;
+            deque_merge_relocate(first + taken[part], first + taken[part + 1], middle + (out_begin - taken[part]),
+                                 middle + (out_end - taken[part + 1]), buffer + out_begin, compare);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    // Parts read from anywhere in the runs, so they are moved back only once every part is merged
+    workers.clear();
+    for (unsigned part = 0; part < parts; part++) {
+        workers.emplace_back([=]() {
+            size_t out_begin = count * part / parts, out_end = count * (part + 1) / parts;
+            std::move(buffer + out_begin, buffer + out_end, first + out_begin);
+            deque_destroy(buffer + out_begin, out_end - out_begin);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    deque_deallocate(buffer, count);
+}
+
+/*
+ * Parallel sort of a contiguous array with the given compare function
+ * The range is split into one chunk per thread, chunks are sorted in parallel and then merged pairwise
+ * in rounds, where all merges of one round run in parallel. Threads are shared out among the merges of a round,
+ * so merges of the last rounds (down to the final single merge) are themselves split into parallel parts.
+ */
+template<typename T, typename Compare>
+void deque_parallel_sort(T *first, T *last, Compare compare, unsigned threads) {
+    size_t count = (size_t) (last - first);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (threads == 1 || count < PARALLEL_SORT_MIN_ELEMENTS) {
+        std::sort(first, last, compare);
+        return;
+    }
+
+    // Chunk boundaries, chunk i is [bounds[i], bounds[i + 1])
+    std::vector<T *> bounds;
+    for (unsigned i = 0; i <= threads; i++) {
+        bounds.push_back(first + count * i / threads);
+    }
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back([&bounds, &compare, i]() {
+            std::sort(bounds[i], bounds[i + 1], compare);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    // Merge neighbouring chunks until one chunk is left
+    while (bounds.size() > 2) {
+        std::vector<T *> merged_bounds;
+        workers.clear();
+        unsigned merges = (unsigned) (bounds.size() - 1) / 2;
+        unsigned parts = std::max(1u, threads / merges);
+        for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+            merged_bounds.push_back(bounds[i]);
+            if (i + 2 < bounds.size()) {
+                T *begin = bounds[i], *middle = bounds[i + 1], *end = bounds[i + 2];
+                workers.emplace_back([begin, middle, end, parts, &compare]() {
+                    deque_parallel_merge(begin, middle, end, compare, parts);
+                });
+            }
+        }
+        merged_bounds.push_back(bounds.back());
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        bounds.swap(merged_bounds);
+    }
+}
+
+/*
+ * Contiguous run of elements inside the buffer of a Deque
+ */
+template<typename T>
+struct DequeSpan {
+    T *data;
+    size_t count;
+};
+
+// Skip bytes already transferred, dropping exhausted entries from the front of iov
+inline void deque_advance_iovec(struct iovec *&iov, int &iov_count, size_t bytes) {
+    while (iov_count > 0 && bytes >= iov->iov_len) {
+        bytes -= iov->iov_len;
+        iov++;
+        iov_count--;
+    }
+    if (iov_count > 0) {
+        iov->iov_base = (char *) iov->iov_base + bytes;
+        iov->iov_len -= bytes;
+    }
+}
+
+// Write all bytes of iov to fd retrying on partial writes, returns number of written bytes or -1 with errno set
+inline ssize_t deque_writev_all(int fd, struct iovec *iov, int iov_count) {
+    ssize_t total_bytes = 0;
+    while (iov_count > 0) {
+        ssize_t bytes = writev(fd, iov, iov_count);
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        total_bytes += bytes;
+        deque_advance_iovec(iov, iov_count, (size_t) bytes);
+    }
+    return total_bytes;
+}
+
+// Read from fd into iov until end of file, iov is full or a whole number of elements has arrived
+// carry_bytes of a partial element are already in front of iov and count towards the element boundary
+// Returns number of read bytes or -1 with errno set if nothing was read
+inline ssize_t deque_readv_elements(int fd, struct iovec *iov, int iov_count, size_t element_size, size_t carry_bytes) {
+    ssize_t total_bytes = 0;
+    while (iov_count > 0) {
+        ssize_t bytes = readv(fd, iov, iov_count);
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return total_bytes == 0 ? -1 : total_bytes;
+        }
+        if (bytes == 0) {
+            break;
+        }
+        total_bytes += bytes;
+        deque_advance_iovec(iov, iov_count, (size_t) bytes);
+        if ((carry_bytes + (size_t) total_bytes) % element_size == 0) {
+            break;
+        }
+    }
+    return total_bytes;
+}
 
 /*
  * Macro to implement methods related to Deque data structure using Stringification
  */
-#define Deque_Custom(t)                                                                                                                         \
+#define Deque_Custom(t) Deque_Custom_Impl(t, 0)
+
+/*
+ * Macro to implement Deque with inline storage for inline_n elements (power of two) inside the structure
+ * Same API as Deque_Custom, the heap is used only once the Deque holds more than inline_n elements,
+ * and shrinking moves the elements back into the structure. The structure must not be copied while in use.
+ * A program uses either Deque_Custom(t) or Deque_Custom_Small(t, inline_n) for a type t.
+ */
+#define Deque_Custom_Small(t, inline_n) Deque_Custom_Impl(t, inline_n)
+
+/*
+ * Internal macro behind Deque_Custom and Deque_Custom_Small
+ */
+#define Deque_Custom_Impl(t, inline_n)                                                                                                          \
     using namespace std;                                                                                                                        \
+    static_assert(((inline_n) & ((inline_n) - 1)) == 0, "Inline capacity of Deque must be a power of two");                                     \
     /* Forward declaration of structure */                                                                                                      \
     struct Deque_##t;                                                                                                                           \
     /* Structure to represent Iterator for Deque */                                                                                             \
     struct Deque_##t##_Iterator {                                                                                                               \
         /* Variable declaration for Deque Iterator */                                                                                           \
         struct Deque_##t *deque_##t;                                                                                                            \
-        int deque_##t##_index;                                                                                                                  \
+        size_t deque_##t##_index;                                                                                                               \
         /* Function Pointer declaration for Deque Iterator */                                                                                   \
         void (*inc)(Deque_##t##_Iterator *it);                                                                                                  \
         void (*dec)(Deque_##t##_Iterator *it);                                                                                                  \
@@ -30,17 +495,31 @@
         /* Variable declaration for Deque */                                                                                                    \
         char type_name[(sizeof "Deque_") + (sizeof #t) - 1];                                                                                    \
         t *t##_list;                                                                                                                            \
-        int list_front_index;                                                                                                                   \
-        int list_back_index;                                                                                                                    \
+        size_t list_front_index;                                                                                                                \
+        /* Back index is (list_front_index + list_elements - 1) & mask, the slot before front when empty */                                     \
+        size_t list_back_index;                                                                                                                 \
         size_t list_capacity;                                                                                                                   \
+        size_t list_capacity_mask;                                                                                                              \
         size_t list_elements;                                                                                                                   \
+        size_t list_shrink_threshold;                                                                                                           \
+        DequeGrowthPolicy growth_policy;                                                                                                        \
+        DequeInlineBuffer<t, inline_n> inline_buffer;                                                                                           \
+        /* Bytes of a partial element left by read_from_fd, completed by the next read */                                                       \
+        unsigned char read_carry[sizeof(t)];                                                                                                    \
+        size_t read_carry_bytes;                                                                                                                \
         /* Function Pointer declaration for Deque */                                                                                            \
         size_t (*size)(Deque_##t *deq);                                                                                                         \
         bool (*empty)(Deque_##t *deq);                                                                                                          \
         void (*push_front)(Deque_##t *deq, t);                                                                                                  \
         void (*push_back)(Deque_##t *deq, t);                                                                                                   \
+        void (*push_front_move)(Deque_##t *deq, t &&);                                                                                          \
+        void (*push_back_move)(Deque_##t *deq, t &&);                                                                                           \
         void (*pop_front)(Deque_##t *deq);                                                                                                      \
         void (*pop_back)(Deque_##t *deq);                                                                                                       \
+        void (*push_front_n)(Deque_##t *deq, const t *src, size_t count);                                                                       \
+        void (*push_back_n)(Deque_##t *deq, const t *src, size_t count);                                                                        \
+        void (*pop_front_n)(Deque_##t *deq, size_t count);                                                                                      \
+        size_t (*copy_out)(Deque_##t *deq, t *dst, size_t count);                                                                               \
         t &(*front)(Deque_##t *deq);                                                                                                            \
         t &(*back)(Deque_##t *deq);                                                                                                             \
         t &(*at)(Deque_##t *deq, size_t i);                                                                                                     \
@@ -50,145 +529,265 @@
         void (*dtor)(Deque_##t *deq);                                                                                                           \
         bool (*compare_elements)(const t &o1, const t &o2);                                                                                     \
         void (*sort)(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end);                                                     \
+        void (*radix_sort)(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end);                                               \
+        void (*parallel_sort)(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end, unsigned threads);                          \
+        size_t (*spans)(Deque_##t *deq, DequeSpan<t> *spans);                                                                                   \
+        void (*reserve)(Deque_##t *deq, size_t capacity);                                                                                       \
+        void (*shrink_to_fit)(Deque_##t *deq);                                                                                                  \
+        void (*set_growth_policy)(Deque_##t *deq, DequeGrowthPolicy policy);                                                                    \
+        ssize_t (*write_to_fd)(Deque_##t *deq, int fd);                                                                                         \
+        ssize_t (*read_from_fd)(Deque_##t *deq, int fd, size_t count);                                                                          \
     };                                                                                                                                          \
     /* Typedef for Deque and Deque Iterator structs */                                                                                          \
     typedef struct Deque_##t##_Iterator Deque_##t##_Iterator;                                                                                   \
     typedef struct Deque_##t Deque_##t;                                                                                                         \
     /* Function returns number of elements present in Deque List */                                                                             \
-    size_t list_size(Deque_##t *deq) {                                                                                                          \
+    inline size_t list_size(Deque_##t *deq) {                                                                                                   \
         return deq->list_elements;                                                                                                              \
     }                                                                                                                                           \
     /* Function returns true if Deque List is empty otherwise false */                                                                          \
-    bool list_empty(Deque_##t *deq) {                                                                                                           \
+    inline bool list_empty(Deque_##t *deq) {                                                                                                    \
         return (deq->list_elements == 0);                                                                                                       \
     }                                                                                                                                           \
-    /* Function to double the capacity of Deque List when it is full with elements */                                                           \
-    void dynamic_deq_capacity(Deque_##t *deq) {                                                                                                 \
-        /* Allocating new memory with doubled size */                                                                                           \
-        int front_index = deq->list_front_index, index = deq->list_front_index;                                                                 \
-        size_t new_capacity = deq->list_capacity * DOUBLE;                                                                                      \
-        auto *new_list = new t[new_capacity];                                                                                                   \
-        if (new_list != nullptr) {                                                                                                              \
-            memset(new_list, 0, new_capacity * sizeof(int));                                                                                    \
-            /* Logic to copy old list data into the newly created list */                                                                       \
-            while (deq->list_front_index != deq->list_back_index) {                                                                             \
-                new_list[index] = deq->t##_list[deq->list_front_index];                                                                         \
-                deq->list_front_index--;                                                                                                        \
-                index--;                                                                                                                        \
-                if (deq->list_front_index < 0) {                                                                                                \
-                    deq->list_front_index += deq->list_capacity;                                                                                \
-                }                                                                                                                               \
-                if (index < 0) {                                                                                                                \
-                    index += new_capacity;                                                                                                      \
-                }                                                                                                                               \
+    /* Function to copy a run of elements, using memcpy when t is trivially copyable */                                                         \
+    inline void copy_elements_deque(t *dst, const t *src, size_t count) {                                                                       \
+        if (is_trivially_copyable<t>::value) {                                                                                                  \
+            memcpy((void *) dst, (const void *) src, count * sizeof(t));                                                                        \
+        } else {                                                                                                                                \
+            std::copy(src, src + count, dst);                                                                                                   \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to copy count elements starting at physical index of Deque List into dst (at most two runs) */                                  \
+    inline void copy_from_ring_deque(Deque_##t *deq, size_t index, t *dst, size_t count) {                                                      \
+        size_t first_run = std::min(count, deq->list_capacity - index);                                                                         \
+        copy_elements_deque(dst, deq->t##_list + index, first_run);                                                                             \
+        copy_elements_deque(dst + first_run, deq->t##_list, count - first_run);                                                                 \
+    }                                                                                                                                           \
+    /* Function to copy construct count elements of src into free slots of Deque List starting at physical index (at most two runs) */          \
+    inline void copy_to_ring_deque(Deque_##t *deq, size_t index, const t *src, size_t count) {                                                  \
+        size_t first_run = std::min(count, deq->list_capacity - index);                                                                         \
+        deque_construct_copies(deq->t##_list + index, src, first_run);                                                                          \
+        deque_construct_copies(deq->t##_list, src + first_run, count - first_run);                                                              \
+    }                                                                                                                                           \
+    /* Function to move all elements of Deque List into uninitialized dst keeping their order (at most two runs) */                             \
+    inline void relocate_from_ring_deque(Deque_##t *deq, t *dst) {                                                                              \
+        size_t first_run = std::min(deq->list_elements, deq->list_capacity - deq->list_front_index);                                            \
+        deque_relocate(dst, deq->t##_list + deq->list_front_index, first_run);                                                                  \
+        deque_relocate(dst + first_run, deq->t##_list, deq->list_elements - first_run);                                                         \
+    }                                                                                                                                           \
+    /* Function to destroy count elements starting at physical index of Deque List (at most two runs) */                                        \
+    inline void destroy_ring_deque(Deque_##t *deq, size_t index, size_t count) {                                                                \
+        size_t first_run = std::min(count, deq->list_capacity - index);                                                                         \
+        deque_destroy(deq->t##_list + index, first_run);                                                                                        \
+        deque_destroy(deq->t##_list, count - first_run);                                                                                        \
+    }                                                                                                                                           \
+    /* Function to update the size below which pops shrink the buffer (0 when growth policy never shrinks) */                                   \
+    inline void update_shrink_threshold_deque(Deque_##t *deq) {                                                                                 \
+        /* Small Deque on the heap may always shrink back into its inline storage */                                                            \
+        bool heap_list = deq->t##_list != deq->inline_buffer.data();                                                                            \
+        bool above_min_capacity = deq->list_capacity > deq->growth_policy.min_capacity || (inline_n) != 0;                                      \
+        bool can_shrink = deq->growth_policy.shrink_divisor != 0 && heap_list && above_min_capacity;                                            \
+        deq->list_shrink_threshold = can_shrink ? deq->list_capacity / deq->growth_policy.shrink_divisor : 0;                                   \
+    }                                                                                                                                           \
+    /* Function returns capacity of the smallest buffer holding count elements (inline storage if they fit into it) */                          \
+    inline size_t fit_capacity_deque(Deque_##t *deq, size_t count) {                                                                            \
+        if ((inline_n) != 0 && count <= (inline_n)) {                                                                                           \
+            return (inline_n);                                                                                                                  \
+        }                                                                                                                                       \
+        return std::max(deq->growth_policy.min_capacity, deque_power_of_two_capacity(count));                                                   \
+    }                                                                                                                                           \
+    /* Function to move elements of Deque List into a new buffer of new_capacity (power of two, at least size) */                               \
+    /* Capacities up to inline_n use the inline storage, which is never moved into itself */                                                    \
+    inline void resize_capacity_deque(Deque_##t *deq, size_t new_capacity) {                                                                    \
+        t *inline_list = deq->inline_buffer.data();                                                                                             \
+        if ((inline_n) != 0 && new_capacity <= (inline_n)) {                                                                                    \
+            if (deq->t##_list == inline_list) {                                                                                                 \
+                return;                                                                                                                         \
             }                                                                                                                                   \
-            /* Copying last element in new list and setting indexes to deque object */                                                          \
-            new_list[index] = deq->t##_list[deq->list_front_index];                                                                             \
+            new_capacity = (inline_n);                                                                                                          \
+        }                                                                                                                                       \
+        auto *new_list = ((inline_n) != 0 && new_capacity == (inline_n)) ? inline_list : deque_allocate<t>(new_capacity);                       \
+        if (new_list != nullptr) {                                                                                                              \
+            /* Logic to move old list data into the newly created list starting from index 0 */                                                 \
+            relocate_from_ring_deque(deq, new_list);                                                                                            \
             auto *temp = deq->t##_list;                                                                                                         \
-            deq->t##_list = nullptr;                                                                                                            \
             deq->t##_list = new_list;                                                                                                           \
-            delete[] temp;                                                                                                                      \
-            deq->list_front_index = front_index;                                                                                                \
-            deq->list_back_index = index;                                                                                                       \
+            if (temp != inline_list) {                                                                                                          \
+                deque_deallocate(temp, deq->list_capacity);                                                                                     \
+            }                                                                                                                                   \
+            deq->list_front_index = 0;                                                                                                          \
+            deq->list_back_index = (deq->list_elements - 1) & (new_capacity - 1);                                                               \
             deq->list_capacity = new_capacity;                                                                                                  \
+            deq->list_capacity_mask = new_capacity - 1;                                                                                         \
+            update_shrink_threshold_deque(deq);                                                                                                 \
         }                                                                                                                                       \
     }                                                                                                                                           \
-    /* Function to push new element from front side to Deque List */                                                                            \
-    void push_front_deque(Deque_##t *deq, t new_##t) {                                                                                          \
-        int front_index = deq->list_front_index;                                                                                                \
-        /* Logic to adjust front index to implement Dynamic Circular Array */                                                                   \
-        if (!deq->empty(deq)) {                                                                                                                 \
-            front_index = (front_index + 1) % deq->list_capacity;                                                                               \
+    /* Function to grow the capacity of Deque List according to growth policy until it can hold min_capacity elements */                        \
+    inline void dynamic_deq_capacity(Deque_##t *deq, size_t min_capacity) {                                                                     \
+        size_t max_factor_capacity = deq->growth_policy.max_factor_capacity;                                                                    \
+        bool factor_growth = max_factor_capacity == 0 || deq->list_capacity < max_factor_capacity;                                              \
+        size_t growth_factor = factor_growth ? deq->growth_policy.growth_factor : DOUBLE;                                                       \
+        /* Small Deque leaving its inline storage starts with a regular heap buffer */                                                          \
+        size_t new_capacity = std::max((size_t) LIST_CAPACITY, deq->list_capacity * growth_factor);                                             \
+        while (new_capacity < min_capacity) {                                                                                                   \
+            new_capacity *= DOUBLE;                                                                                                             \
+        }                                                                                                                                       \
+        resize_capacity_deque(deq, new_capacity);                                                                                               \
+    }                                                                                                                                           \
+    /* Function to shrink the buffer once Deque List got smaller than shrink threshold of growth policy */                                      \
+    /* New capacity is at least twice the size, so that a few pushes do not grow the buffer right away */                                       \
+    inline void dynamic_deq_shrink(Deque_##t *deq) {                                                                                            \
+        size_t new_capacity = fit_capacity_deque(deq, deq->list_elements * DOUBLE);                                                             \
+        if (new_capacity < deq->list_capacity) {                                                                                                \
+            resize_capacity_deque(deq, new_capacity);                                                                                           \
         }                                                                                                                                       \
-        deq->t##_list[front_index] = new_##t;                                                                                                   \
+    }                                                                                                                                           \
+    /* Function to construct new element from args at front side of full Deque List after growing the buffer */                                 \
+    /* Arguments may refer to elements of Deque, so the new element is built before the buffer moves */                                         \
+    /* (slow path is kept apart from emplace so that the push fast path stays small enough to inline) */                                        \
+    template<typename... Args>                                                                                                                  \
+    void emplace_front_grow_deque(Deque_##t *deq, Args &&... args) {                                                                            \
+        t new_##t(std::forward<Args>(args)...);                                                                                                 \
+        dynamic_deq_capacity(deq, deq->list_elements + 1);                                                                                      \
+        deq->list_front_index = (deq->list_front_index - 1) & deq->list_capacity_mask;                                                          \
+        new (deq->t##_list + deq->list_front_index) t(std::move(new_##t));                                                                      \
         deq->list_elements++;                                                                                                                   \
-        deq->list_front_index = front_index;                                                                                                    \
-        /* Increase the capacity of Deque once it is full */                                                                                    \
+    }                                                                                                                                           \
+    /* Function to construct new element from args at back side of full Deque List after growing the buffer */                                  \
+    template<typename... Args>                                                                                                                  \
+    void emplace_back_grow_deque(Deque_##t *deq, Args &&... args) {                                                                             \
+        t new_##t(std::forward<Args>(args)...);                                                                                                 \
+        dynamic_deq_capacity(deq, deq->list_elements + 1);                                                                                      \
+        deq->list_back_index = (deq->list_front_index + deq->list_elements) & deq->list_capacity_mask;                                          \
+        new (deq->t##_list + deq->list_back_index) t(std::move(new_##t));                                                                       \
+        deq->list_elements++;                                                                                                                   \
+    }                                                                                                                                           \
+    /* Function to construct new element in place from args at front side of Deque List */                                                      \
+    template<typename... Args>                                                                                                                  \
+    inline void emplace_front_deque(Deque_##t *deq, Args &&... args) {                                                                          \
         if (deq->list_elements == deq->list_capacity) {                                                                                         \
-            dynamic_deq_capacity(deq);                                                                                                          \
+            emplace_front_grow_deque(deq, std::forward<Args>(args)...);                                                                         \
+            return;                                                                                                                             \
         }                                                                                                                                       \
+        /* Element i of the Deque is stored at (front index + i) & mask, so front moves one slot down */                                        \
+        size_t front_index = (deq->list_front_index - 1) & deq->list_capacity_mask;                                                             \
+        new (deq->t##_list + front_index) t(std::forward<Args>(args)...);                                                                       \
+        deq->list_front_index = front_index;                                                                                                    \
+        deq->list_back_index = (front_index + deq->list_elements) & deq->list_capacity_mask;                                                    \
+        deq->list_elements++;                                                                                                                   \
     }                                                                                                                                           \
-    /* Function to push new element from back side to Deque List */                                                                             \
-    void push_back_deque(Deque_##t *deq, t new_##t) {                                                                                           \
-        int back_index = deq->list_back_index;                                                                                                  \
-        if (deq->empty(deq)) {                                                                                                                  \
-            /* Element will be stored at the 0th index of myClass_list if it is empty */                                                        \
-            deq->t##_list[back_index] = new_##t;                                                                                                \
-            deq->list_elements++;                                                                                                               \
-            deq->list_back_index = back_index;                                                                                                  \
-        } else {                                                                                                                                \
-            back_index--;                                                                                                                       \
-            /* Handling condition if back_index becomes -1 (after successive two push_backs on empty myClass_list) */                           \
-            if (back_index < 0) {                                                                                                               \
-                back_index = back_index + deq->list_capacity;                                                                                   \
-            }                                                                                                                                   \
-            deq->t##_list[back_index] = new_##t;                                                                                                \
-            deq->list_elements++;                                                                                                               \
-            deq->list_back_index = back_index;                                                                                                  \
-        }                                                                                                                                       \
-        /* Increase the capacity of Deque once it is full */                                                                                    \
+    /* Function to construct new element in place from args at back side of Deque List */                                                       \
+    template<typename... Args>                                                                                                                  \
+    inline void emplace_back_deque(Deque_##t *deq, Args &&... args) {                                                                           \
         if (deq->list_elements == deq->list_capacity) {                                                                                         \
-            dynamic_deq_capacity(deq);                                                                                                          \
+            emplace_back_grow_deque(deq, std::forward<Args>(args)...);                                                                          \
+            return;                                                                                                                             \
         }                                                                                                                                       \
+        size_t back_index = (deq->list_front_index + deq->list_elements) & deq->list_capacity_mask;                                             \
+        new (deq->t##_list + back_index) t(std::forward<Args>(args)...);                                                                        \
+        deq->list_back_index = back_index;                                                                                                      \
+        deq->list_elements++;                                                                                                                   \
+    }                                                                                                                                           \
+    /* Function to push new element from front side to Deque List */                                                                            \
+    inline void push_front_deque(Deque_##t *deq, t new_##t) {                                                                                   \
+        emplace_front_deque(deq, std::move(new_##t));                                                                                           \
+    }                                                                                                                                           \
+    /* Function to push new element from back side to Deque List */                                                                             \
+    inline void push_back_deque(Deque_##t *deq, t new_##t) {                                                                                    \
+        emplace_back_deque(deq, std::move(new_##t));                                                                                            \
+    }                                                                                                                                           \
+    /* Function to move new element into front side of Deque List */                                                                            \
+    inline void push_front_move_deque(Deque_##t *deq, t &&new_##t) {                                                                            \
+        emplace_front_deque(deq, std::move(new_##t));                                                                                           \
+    }                                                                                                                                           \
+    /* Function to move new element into back side of Deque List */                                                                             \
+    inline void push_back_move_deque(Deque_##t *deq, t &&new_##t) {                                                                             \
+        emplace_back_deque(deq, std::move(new_##t));                                                                                            \
     }                                                                                                                                           \
     /* Function to pop element from front side from Deque List */                                                                               \
-    void pop_front_deque(Deque_##t *deq) {                                                                                                      \
-        int front_index = deq->list_front_index;                                                                                                \
-        if (!deq->empty(deq)) {                                                                                                                 \
-            front_index--;                                                                                                                      \
-            /* Adjust front index of list */                                                                                                    \
-            if (front_index < 0) {                                                                                                              \
-                front_index = front_index + deq->list_capacity;                                                                                 \
-            }                                                                                                                                   \
+    inline void pop_front_deque(Deque_##t *deq) {                                                                                               \
+        if (!list_empty(deq)) {                                                                                                                 \
+            deque_destroy(deq->t##_list + deq->list_front_index, 1);                                                                            \
+            deq->list_front_index = (deq->list_front_index + 1) & deq->list_capacity_mask;                                                      \
             deq->list_elements--;                                                                                                               \
-            deq->list_front_index = front_index;                                                                                                \
+            if (deq->list_elements < deq->list_shrink_threshold) {                                                                              \
+                dynamic_deq_shrink(deq);                                                                                                        \
+            }                                                                                                                                   \
         }                                                                                                                                       \
     }                                                                                                                                           \
     /* Function to pop element from back side from Deque List */                                                                                \
-    void pop_back_deque(Deque_##t *deq) {                                                                                                       \
-        int back_index = deq->list_back_index;                                                                                                  \
-        if (!deq->empty(deq)) {                                                                                                                 \
-            /* Adjust back index of list */                                                                                                     \
-            back_index = (back_index + 1) % deq->list_capacity;                                                                                 \
+    inline void pop_back_deque(Deque_##t *deq) {                                                                                                \
+        if (!list_empty(deq)) {                                                                                                                 \
+            deque_destroy(deq->t##_list + deq->list_back_index, 1);                                                                             \
+            deq->list_back_index = (deq->list_back_index - 1) & deq->list_capacity_mask;                                                        \
             deq->list_elements--;                                                                                                               \
-            deq->list_back_index = back_index;                                                                                                  \
+            if (deq->list_elements < deq->list_shrink_threshold) {                                                                              \
+                dynamic_deq_shrink(deq);                                                                                                        \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to push count elements of src to back side of Deque List (src[0] is pushed first) */                                            \
+    inline void push_back_n_deque(Deque_##t *deq, const t *src, size_t count) {                                                                 \
+        if (deq->list_elements + count > deq->list_capacity) {                                                                                  \
+            dynamic_deq_capacity(deq, deq->list_elements + count);                                                                              \
         }                                                                                                                                       \
+        copy_to_ring_deque(deq, (deq->list_front_index + deq->list_elements) & deq->list_capacity_mask, src, count);                            \
+        deq->list_elements += count;                                                                                                            \
+        deq->list_back_index = (deq->list_front_index + deq->list_elements - 1) & deq->list_capacity_mask;                                      \
+    }                                                                                                                                           \
+    /* Function to push count elements of src to front side of Deque List keeping their order (src[0] becomes front) */                         \
+    inline void push_front_n_deque(Deque_##t *deq, const t *src, size_t count) {                                                                \
+        if (deq->list_elements + count > deq->list_capacity) {                                                                                  \
+            dynamic_deq_capacity(deq, deq->list_elements + count);                                                                              \
+        }                                                                                                                                       \
+        deq->list_front_index = (deq->list_front_index - count) & deq->list_capacity_mask;                                                      \
+        copy_to_ring_deque(deq, deq->list_front_index, src, count);                                                                             \
+        deq->list_elements += count;                                                                                                            \
+        deq->list_back_index = (deq->list_front_index + deq->list_elements - 1) & deq->list_capacity_mask;                                      \
+    }                                                                                                                                           \
+    /* Function to pop up to count elements from front side from Deque List */                                                                  \
+    inline void pop_front_n_deque(Deque_##t *deq, size_t count) {                                                                               \
+        count = std::min(count, deq->list_elements);                                                                                            \
+        destroy_ring_deque(deq, deq->list_front_index, count);                                                                                  \
+        deq->list_front_index = (deq->list_front_index + count) & deq->list_capacity_mask;                                                      \
+        deq->list_elements -= count;                                                                                                            \
+        if (deq->list_elements < deq->list_shrink_threshold) {                                                                                  \
+            dynamic_deq_shrink(deq);                                                                                                            \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to copy up to count elements from front side of Deque List into dst, returns number of copied elements */                       \
+    inline size_t copy_out_deque(Deque_##t *deq, t *dst, size_t count) {                                                                        \
+        count = std::min(count, deq->list_elements);                                                                                            \
+        copy_from_ring_deque(deq, deq->list_front_index, dst, count);                                                                           \
+        return count;                                                                                                                           \
     }                                                                                                                                           \
     /* Function returns element from front side from Deque List */                                                                              \
-    t &front_deque(Deque_##t *deq) {                                                                                                            \
+    inline t &front_deque(Deque_##t *deq) {                                                                                                     \
         return deq->t##_list[deq->list_front_index];                                                                                            \
     }                                                                                                                                           \
     /* Function returns element from back side from Deque List */                                                                               \
-    t &back_deque(Deque_##t *deq) {                                                                                                             \
+    inline t &back_deque(Deque_##t *deq) {                                                                                                      \
         return deq->t##_list[deq->list_back_index];                                                                                             \
     }                                                                                                                                           \
     /* Function returns element at the required index from Deque List */                                                                        \
-    t &at_deque(Deque_##t *deq, size_t req_index) {                                                                                             \
-        int index = deq->list_front_index - req_index;                                                                                          \
-        if (index < 0) {                                                                                                                        \
-            index = index + deq->list_capacity;                                                                                                 \
-        }                                                                                                                                       \
-        return deq->t##_list[index];                                                                                                            \
+    inline t &at_deque(Deque_##t *deq, size_t req_index) {                                                                                      \
+        return deq->t##_list[(deq->list_front_index + req_index) & deq->list_capacity_mask];                                                    \
     }                                                                                                                                           \
     /* Function to increment the iterator index by 1 */                                                                                         \
-    void inc_deque(Deque_##t##_Iterator *it) {                                                                                                  \
+    inline void inc_deque(Deque_##t##_Iterator *it) {                                                                                           \
         it->deque_##t##_index++;                                                                                                                \
     }                                                                                                                                           \
     /* Function to decrement the iterator index by 1 */                                                                                         \
-    void dec_deque(Deque_##t##_Iterator *it) {                                                                                                  \
+    inline void dec_deque(Deque_##t##_Iterator *it) {                                                                                           \
         it->deque_##t##_index--;                                                                                                                \
     }                                                                                                                                           \
     /* Function returns the element at iterator index */                                                                                        \
-    t &deref_deque(Deque_##t##_Iterator *it) {                                                                                                  \
+    inline t &deref_deque(Deque_##t##_Iterator *it) {                                                                                           \
         Deque_##t *deq_##t = it->deque_##t;                                                                                                     \
-        int index = deq_##t->list_front_index - it->deque_##t##_index;                                                                          \
-        if (index < 0) {                                                                                                                        \
-            index = index + deq_##t->list_capacity;                                                                                             \
-        }                                                                                                                                       \
-        return deq_##t->t##_list[index];                                                                                                        \
+        return deq_##t->t##_list[(deq_##t->list_front_index + it->deque_##t##_index) & deq_##t->list_capacity_mask];                            \
     }                                                                                                                                           \
     /* Function returns Deque Iterator object with begin index as 0 */                                                                          \
-    Deque_##t##_Iterator begin_deque(Deque_##t *deq) {                                                                                          \
+    inline Deque_##t##_Iterator begin_deque(Deque_##t *deq) {                                                                                   \
         Deque_##t##_Iterator t##_iter{};                                                                                                        \
         t##_iter.deque_##t = deq;                                                                                                               \
         t##_iter.deque_##t##_index = BEGIN_INDEX;                                                                                               \
@@ -198,7 +797,7 @@
         return t##_iter;                                                                                                                        \
     }                                                                                                                                           \
     /* Function returns Deque Iterator object with end index as number of elements in Deque List */                                             \
-    Deque_##t##_Iterator end_deque(Deque_##t *deq) {                                                                                            \
+    inline Deque_##t##_Iterator end_deque(Deque_##t *deq) {                                                                                     \
         Deque_##t##_Iterator t##_iter{};                                                                                                        \
         t##_iter.deque_##t = deq;                                                                                                               \
         t##_iter.deque_##t##_index = deq->list_elements;                                                                                        \
@@ -208,79 +807,320 @@
         return t##_iter;                                                                                                                        \
     }                                                                                                                                           \
     /* Function returns true when passed argument are equal otherwise false */                                                                  \
-    bool Deque_##t##_Iterator_equal(Deque_##t##_Iterator start, Deque_##t##_Iterator end) {                                                     \
+    inline bool Deque_##t##_Iterator_equal(Deque_##t##_Iterator start, Deque_##t##_Iterator end) {                                              \
         return (start.deque_##t##_index == end.deque_##t##_index);                                                                              \
     }                                                                                                                                           \
     /* Function returns true when both Deque Lists are same otherwise false  */                                                                 \
-    bool Deque_##t##_equal(Deque_##t deq1, Deque_##t deq2) {                                                                                    \
+    inline bool Deque_##t##_equal(Deque_##t deq1, Deque_##t deq2) {                                                                             \
         /* Both parameters should have same number of elements */                                                                               \
         if (deq1.list_elements != deq2.list_elements) {                                                                                         \
             return false;                                                                                                                       \
         }                                                                                                                                       \
         /* Elements should be present at the same index in respective myClass_list */                                                           \
         for (size_t i = 0; i < deq1.list_elements; i++) {                                                                                       \
-            t t##_1 = deq1.at(&deq1, i);                                                                                                        \
-            t t##_2 = deq2.at(&deq2, i);                                                                                                        \
+            t t##_1 = at_deque(&deq1, i);                                                                                                       \
+            t t##_2 = at_deque(&deq2, i);                                                                                                       \
             if (deq1.compare_elements(t##_1, t##_2) || deq2.compare_elements(t##_2, t##_1)) {                                                   \
                 return false;                                                                                                                   \
             }                                                                                                                                   \
         }                                                                                                                                       \
         return true;                                                                                                                            \
     }                                                                                                                                           \
-    /* Function to reset all indexes as it was during constructing the Deque */                                                                 \
-    void clear_deque(Deque_##t *deq) {                                                                                                          \
+    /* Function to destroy all elements and reset all indexes as it was during constructing the Deque */                                        \
+    inline void clear_deque(Deque_##t *deq) {                                                                                                   \
+        destroy_ring_deque(deq, deq->list_front_index, deq->list_elements);                                                                     \
         deq->list_elements = 0;                                                                                                                 \
         deq->list_front_index = 0;                                                                                                              \
-        deq->list_back_index = 0;                                                                                                               \
+        deq->list_back_index = deq->list_capacity_mask;                                                                                         \
+        if (deq->list_shrink_threshold != 0) {                                                                                                  \
+            dynamic_deq_shrink(deq);                                                                                                            \
+        }                                                                                                                                       \
     }                                                                                                                                           \
     /* Function to deallocate all the heap memory allocations for Deque List */                                                                 \
-    void dtor_deque(Deque_##t *deq) {                                                                                                           \
-        delete[] deq->t##_list;                                                                                                                 \
+    inline void dtor_deque(Deque_##t *deq) {                                                                                                    \
+        destroy_ring_deque(deq, deq->list_front_index, deq->list_elements);                                                                     \
+        deq->list_elements = 0;                                                                                                                 \
+        if (deq->t##_list != deq->inline_buffer.data()) {                                                                                       \
+            deque_deallocate(deq->t##_list, deq->list_capacity);                                                                                \
+        }                                                                                                                                       \
         deq->t##_list = nullptr;                                                                                                                \
     }                                                                                                                                           \
-    /* Function to sort elements of Deque List according to respective compare functions */                                                     \
-    void sort_list(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end) {                                                      \
-        int i, begin_index = begin.deque_##t##_index;                                                                                           \
-        int end_index = end.deque_##t##_index;                                                                                                  \
-        int sort_list_size = end_index - begin_index;                                                                                           \
-        t *sorted_list = new t[sort_list_size];                                                                                                 \
-        /* Logic to copy elements according to passed begin and end iterators */                                                                \
-        for (i = 0; i < sort_list_size; i++) {                                                                                                  \
-            sorted_list[i] = begin.deref(&begin);                                                                                               \
-            begin.inc(&begin);                                                                                                                  \
-        }                                                                                                                                       \
-        /* Sorting of elements using C++ standard library std::sort(array, size, compare) */                                                    \
-        sort(sorted_list, sorted_list + sort_list_size, deq->compare_elements);                                                                 \
-        /* Copying back the sorted elements in the original Deque at respective indexes */                                                      \
-        int b_index = begin_index, index = 0;                                                                                                   \
-        for (i = 0; i < sort_list_size; i++) {                                                                                                  \
-            index = deq->list_front_index - b_index;                                                                                            \
-            if (index < 0) {                                                                                                                    \
-                index += deq->list_capacity;                                                                                                    \
+    /* Function returns random access iterator to the element at given index (invalidated by growth and by sort) */                             \
+    inline DequeRingIterator<t> ring_iterator_deque(Deque_##t *deq, size_t index) {                                                             \
+        return DequeRingIterator<t>(deq->t##_list, deq->list_front_index, deq->list_capacity_mask, index);                                      \
+    }                                                                                                                                           \
+    /* Function to move elements in place so that front element is stored at index 0 (elements stay contiguous) */                              \
+    /* Front run is moved down next to the wrapped run through the free slots, then only occupied slots are rotated */                          \
+    /* (a full buffer has no free slots, the front run already follows the wrapped run and is only rotated) */                                  \
+    inline void linearize_deque(Deque_##t *deq) {                                                                                               \
+        if (deq->list_front_index != 0) {                                                                                                       \
+            size_t first_run = std::min(deq->list_elements, deq->list_capacity - deq->list_front_index);                                        \
+            size_t wrapped_run = deq->list_elements - first_run;                                                                                \
+            if (wrapped_run != deq->list_front_index) {                                                                                         \
+                deque_relocate_down(deq->t##_list + wrapped_run, deq->t##_list + deq->list_front_index, first_run);                             \
             }                                                                                                                                   \
-            deq->t##_list[index] = sorted_list[i];                                                                                              \
-            b_index++;                                                                                                                          \
+            if (wrapped_run != 0) {                                                                                                             \
+                rotate(deq->t##_list, deq->t##_list + wrapped_run, deq->t##_list + deq->list_elements);                                         \
+            }                                                                                                                                   \
+            deq->list_front_index = 0;                                                                                                          \
+            deq->list_back_index = (deq->list_elements - 1) & deq->list_capacity_mask;                                                          \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function returns address of the element at begin_index, linearizing the buffer if range [begin_index, end_index) wraps */                \
+    inline t *contiguous_range_deque(Deque_##t *deq, size_t begin_index, size_t end_index) {                                                    \
+        if (((deq->list_front_index + begin_index) & deq->list_capacity_mask) + (end_index - begin_index) > deq->list_capacity) {               \
+            linearize_deque(deq);                                                                                                               \
+        }                                                                                                                                       \
+        return deq->t##_list + ((deq->list_front_index + begin_index) & deq->list_capacity_mask);                                               \
+    }                                                                                                                                           \
+    /* Function to sort elements of Deque List in place according to respective compare functions */                                            \
+    inline void sort_list(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end) {                                               \
+        size_t sort_list_size = end.deque_##t##_index - begin.deque_##t##_index;                                                                \
+        t *range_begin = contiguous_range_deque(deq, begin.deque_##t##_index, end.deque_##t##_index);                                           \
+        sort(range_begin, range_begin + sort_list_size, deq->compare_elements);                                                                 \
+    }                                                                                                                                           \
+    /* Function to sort elements of Deque List according to respective compare functions using threads (0 means all cores) */                   \
+    inline void parallel_sort_list(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end, unsigned threads) {                    \
+        size_t sort_list_size = end.deque_##t##_index - begin.deque_##t##_index;                                                                \
+        t *range_begin = contiguous_range_deque(deq, begin.deque_##t##_index, end.deque_##t##_index);                                           \
+        deque_parallel_sort(range_begin, range_begin + sort_list_size, deq->compare_elements, threads);                                         \
+    }                                                                                                                                           \
+    /* Function to sort elements of Deque List in place in ascending order of values */                                                         \
+    /* Integral t uses radix sort when compare_elements is ascending, other orders and types sort with compare_elements */                      \
+    inline void radix_sort_list(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end) {                                         \
+        size_t sort_list_size = end.deque_##t##_index - begin.deque_##t##_index;                                                                \
+        t *range_begin = contiguous_range_deque(deq, begin.deque_##t##_index, end.deque_##t##_index);                                           \
+        deque_radix_sort(range_begin, range_begin + sort_list_size, deq->compare_elements, deque_radix_sortable<t>());                          \
+    }                                                                                                                                           \
+    /* Function to grow the buffer so that Deque List can hold capacity elements without reallocation */                                        \
+    inline void reserve_deque(Deque_##t *deq, size_t capacity) {                                                                                \
+        if (capacity > deq->list_capacity) {                                                                                                    \
+            resize_capacity_deque(deq, deque_power_of_two_capacity(capacity));                                                                  \
         }                                                                                                                                       \
-        delete[] sorted_list;                                                                                                                   \
+    }                                                                                                                                           \
+    /* Function to release unused memory, shrinking the buffer to the smallest power of two holding all elements */                             \
+    /* (never below min capacity of growth policy, unless the elements fit into inline storage) */                                              \
+    inline void shrink_to_fit_deque(Deque_##t *deq) {                                                                                           \
+        size_t new_capacity = fit_capacity_deque(deq, deq->list_elements);                                                                      \
+        if (new_capacity < deq->list_capacity) {                                                                                                \
+            resize_capacity_deque(deq, new_capacity);                                                                                           \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to set growth policy of Deque List, factors and capacities are rounded up to powers of two */                                   \
+    inline void set_growth_policy_deque(Deque_##t *deq, DequeGrowthPolicy policy) {                                                             \
+        size_t growth_factor = DOUBLE;                                                                                                          \
+        while (growth_factor < policy.growth_factor) {                                                                                          \
+            growth_factor *= DOUBLE;                                                                                                            \
+        }                                                                                                                                       \
+        deq->growth_policy.growth_factor = growth_factor;                                                                                       \
+        deq->growth_policy.max_factor_capacity = policy.max_factor_capacity;                                                                    \
+        deq->growth_policy.shrink_divisor = (policy.shrink_divisor == 0) ? 0 : std::max((size_t) 4, policy.shrink_divisor);                     \
+        deq->growth_policy.min_capacity = deque_power_of_two_capacity(policy.min_capacity);                                                     \
+        update_shrink_threshold_deque(deq);                                                                                                     \
+    }                                                                                                                                           \
+    /* Function to store live elements of Deque List as front segment and wrapped segment into spans[2], returns number of spans */             \
+    inline size_t spans_deque(Deque_##t *deq, DequeSpan<t> *spans) {                                                                            \
+        size_t first_run = std::min(deq->list_elements, deq->list_capacity - deq->list_front_index);                                            \
+        spans[0] = DequeSpan<t>{deq->t##_list + deq->list_front_index, first_run};                                                              \
+        spans[1] = DequeSpan<t>{deq->t##_list, deq->list_elements - first_run};                                                                 \
+        return (spans[1].count != 0) ? 2 : (spans[0].count != 0) ? 1 : 0;                                                                       \
+    }                                                                                                                                           \
+    /* Function to write raw bytes of all elements of Deque List to fd with writev straight from the buffer (elements stay in Deque) */         \
+    /* Returns number of written bytes, or -1 with errno set (EINVAL if t is not trivially copyable) */                                         \
+    inline ssize_t write_to_fd_deque(Deque_##t *deq, int fd) {                                                                                  \
+        if (!is_trivially_copyable<t>::value) {                                                                                                 \
+            errno = EINVAL;                                                                                                                     \
+            return -1;                                                                                                                          \
+        }                                                                                                                                       \
+        DequeSpan<t> spans[2];                                                                                                                  \
+        int span_count = (int) spans_deque(deq, spans);                                                                                         \
+        struct iovec iov[2];                                                                                                                    \
+        for (int i = 0; i < span_count; i++) {                                                                                                  \
+            iov[i].iov_base = (void *) spans[i].data;                                                                                           \
+            iov[i].iov_len = spans[i].count * sizeof(t);                                                                                        \
+        }                                                                                                                                       \
+        return deque_writev_all(fd, iov, span_count);                                                                                           \
+    }                                                                                                                                           \
+    /* Function to read up to count elements from fd with readv straight into free slots at back side of Deque List */                          \
+    /* Returns number of pushed elements, or -1 with errno set */                                                                               \
+    /* Bytes of a trailing partial element (EAGAIN or end of file mid-element) are kept and completed by the next call */                       \
+    inline ssize_t read_from_fd_deque(Deque_##t *deq, int fd, size_t count) {                                                                   \
+        if (!is_trivially_copyable<t>::value) {                                                                                                 \
+            errno = EINVAL;                                                                                                                     \
+            return -1;                                                                                                                          \
+        }                                                                                                                                       \
+        if (count == 0) {                                                                                                                       \
+            return 0;                                                                                                                           \
+        }                                                                                                                                       \
+        if (deq->list_elements + count > deq->list_capacity) {                                                                                  \
+            dynamic_deq_capacity(deq, deq->list_elements + count);                                                                              \
+        }                                                                                                                                       \
+        size_t back_index = (deq->list_front_index + deq->list_elements) & deq->list_capacity_mask;                                             \
+        size_t first_run = std::min(count, deq->list_capacity - back_index);                                                                    \
+        /* Carried bytes go in front of the first free slot, readv completes the element */                                                     \
+        size_t carry_bytes = deq->read_carry_bytes;                                                                                             \
+        memcpy((void *) (deq->t##_list + back_index), deq->read_carry, carry_bytes);                                                            \
+        struct iovec iov[2];                                                                                                                    \
+        iov[0].iov_base = (void *) ((unsigned char *) (deq->t##_list + back_index) + carry_bytes);                                              \
+        iov[0].iov_len = first_run * sizeof(t) - carry_bytes;                                                                                   \
+        iov[1].iov_base = (void *) deq->t##_list;                                                                                               \
+        iov[1].iov_len = (count - first_run) * sizeof(t);                                                                                       \
+        ssize_t bytes = deque_readv_elements(fd, iov, (count == first_run) ? 1 : 2, sizeof(t), carry_bytes);                                    \
+        if (bytes < 0) {                                                                                                                        \
+            return -1;                                                                                                                          \
+        }                                                                                                                                       \
+        size_t total_bytes = carry_bytes + (size_t) bytes;                                                                                      \
+        size_t read_elements = total_bytes / sizeof(t);                                                                                         \
+        /* Keep bytes of a trailing partial element for the next call */                                                                        \
+        deq->read_carry_bytes = total_bytes % sizeof(t);                                                                                        \
+        if (deq->read_carry_bytes != 0) {                                                                                                       \
+            const unsigned char *partial = (const unsigned char *) (deq->t##_list + ((back_index + read_elements) & deq->list_capacity_mask));  \
+            memcpy(deq->read_carry, partial, deq->read_carry_bytes);                                                                            \
+        }                                                                                                                                       \
+        if (read_elements != 0) {                                                                                                               \
+            deq->list_elements += read_elements;                                                                                                \
+            deq->list_back_index = (deq->list_front_index + deq->list_elements - 1) & deq->list_capacity_mask;                                  \
+        }                                                                                                                                       \
+        return (ssize_t) read_elements;                                                                                                         \
+    }                                                                                                                                           \
+    /* Direct-call API, same operations as the function pointers but can be inlined in hot loops */                                             \
+    inline size_t Deque_##t##_size(Deque_##t *deq) {                                                                                            \
+        return list_size(deq);                                                                                                                  \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_empty(Deque_##t *deq) {                                                                                             \
+        return list_empty(deq);                                                                                                                 \
+    }                                                                                                                                           \
+    inline void Deque_##t##_push_front(Deque_##t *deq, t new_##t) {                                                                             \
+        push_front_deque(deq, std::move(new_##t));                                                                                              \
+    }                                                                                                                                           \
+    inline void Deque_##t##_push_back(Deque_##t *deq, t new_##t) {                                                                              \
+        push_back_deque(deq, std::move(new_##t));                                                                                               \
+    }                                                                                                                                           \
+    inline void Deque_##t##_push_front_move(Deque_##t *deq, t &&new_##t) {                                                                      \
+        push_front_move_deque(deq, std::move(new_##t));                                                                                         \
+    }                                                                                                                                           \
+    inline void Deque_##t##_push_back_move(Deque_##t *deq, t &&new_##t) {                                                                       \
+        push_back_move_deque(deq, std::move(new_##t));                                                                                          \
+    }                                                                                                                                           \
+    template<typename... Args>                                                                                                                  \
+    inline void Deque_##t##_emplace_front(Deque_##t *deq, Args &&... args) {                                                                    \
+        emplace_front_deque(deq, std::forward<Args>(args)...);                                                                                  \
+    }                                                                                                                                           \
+    template<typename... Args>                                                                                                                  \
+    inline void Deque_##t##_emplace_back(Deque_##t *deq, Args &&... args) {                                                                     \
+        emplace_back_deque(deq, std::forward<Args>(args)...);                                                                                   \
+    }                                                                                                                                           \
+    inline void Deque_##t##_pop_front(Deque_##t *deq) {                                                                                         \
+        pop_front_deque(deq);                                                                                                                   \
+    }                                                                                                                                           \
+    inline void Deque_##t##_pop_back(Deque_##t *deq) {                                                                                          \
+        pop_back_deque(deq);                                                                                                                    \
+    }                                                                                                                                           \
+    inline void Deque_##t##_push_front_n(Deque_##t *deq, const t *src, size_t count) {                                                          \
+        push_front_n_deque(deq, src, count);                                                                                                    \
+    }                                                                                                                                           \
+    inline void Deque_##t##_push_back_n(Deque_##t *deq, const t *src, size_t count) {                                                           \
+        push_back_n_deque(deq, src, count);                                                                                                     \
+    }                                                                                                                                           \
+    inline void Deque_##t##_pop_front_n(Deque_##t *deq, size_t count) {                                                                         \
+        pop_front_n_deque(deq, count);                                                                                                          \
+    }                                                                                                                                           \
+    inline size_t Deque_##t##_copy_out(Deque_##t *deq, t *dst, size_t count) {                                                                  \
+        return copy_out_deque(deq, dst, count);                                                                                                 \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_front(Deque_##t *deq) {                                                                                               \
+        return front_deque(deq);                                                                                                                \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_back(Deque_##t *deq) {                                                                                                \
+        return back_deque(deq);                                                                                                                 \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_at(Deque_##t *deq, size_t req_index) {                                                                                \
+        return at_deque(deq, req_index);                                                                                                        \
+    }                                                                                                                                           \
+    inline Deque_##t##_Iterator Deque_##t##_begin(Deque_##t *deq) {                                                                             \
+        return begin_deque(deq);                                                                                                                \
+    }                                                                                                                                           \
+    inline Deque_##t##_Iterator Deque_##t##_end(Deque_##t *deq) {                                                                               \
+        return end_deque(deq);                                                                                                                  \
+    }                                                                                                                                           \
+    inline void Deque_##t##_clear(Deque_##t *deq) {                                                                                             \
+        clear_deque(deq);                                                                                                                       \
+    }                                                                                                                                           \
+    inline void Deque_##t##_dtor(Deque_##t *deq) {                                                                                              \
+        dtor_deque(deq);                                                                                                                        \
+    }                                                                                                                                           \
+    inline void Deque_##t##_sort(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end) {                                        \
+        sort_list(deq, begin, end);                                                                                                             \
+    }                                                                                                                                           \
+    inline void Deque_##t##_radix_sort(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end) {                                  \
+        radix_sort_list(deq, begin, end);                                                                                                       \
+    }                                                                                                                                           \
+    inline void Deque_##t##_parallel_sort(Deque_##t *deq, Deque_##t##_Iterator begin, Deque_##t##_Iterator end, unsigned threads) {             \
+        parallel_sort_list(deq, begin, end, threads);                                                                                           \
+    }                                                                                                                                           \
+    inline size_t Deque_##t##_spans(Deque_##t *deq, DequeSpan<t> *spans) {                                                                      \
+        return spans_deque(deq, spans);                                                                                                         \
+    }                                                                                                                                           \
+    inline ssize_t Deque_##t##_write_to_fd(Deque_##t *deq, int fd) {                                                                            \
+        return write_to_fd_deque(deq, fd);                                                                                                      \
+    }                                                                                                                                           \
+    inline ssize_t Deque_##t##_read_from_fd(Deque_##t *deq, int fd, size_t count) {                                                             \
+        return read_from_fd_deque(deq, fd, count);                                                                                              \
+    }                                                                                                                                           \
+    inline void Deque_##t##_reserve(Deque_##t *deq, size_t capacity) {                                                                          \
+        reserve_deque(deq, capacity);                                                                                                           \
+    }                                                                                                                                           \
+    inline void Deque_##t##_shrink_to_fit(Deque_##t *deq) {                                                                                     \
+        shrink_to_fit_deque(deq);                                                                                                               \
+    }                                                                                                                                           \
+    inline void Deque_##t##_set_growth_policy(Deque_##t *deq, DequeGrowthPolicy policy) {                                                       \
+        set_growth_policy_deque(deq, policy);                                                                                                   \
+    }                                                                                                                                           \
+    inline DequeRingIterator<t> Deque_##t##_ring_begin(Deque_##t *deq) {                                                                        \
+        return ring_iterator_deque(deq, BEGIN_INDEX);                                                                                           \
+    }                                                                                                                                           \
+    inline DequeRingIterator<t> Deque_##t##_ring_end(Deque_##t *deq) {                                                                          \
+        return ring_iterator_deque(deq, deq->list_elements);                                                                                    \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Iterator_inc(Deque_##t##_Iterator *it) {                                                                            \
+        inc_deque(it);                                                                                                                          \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Iterator_dec(Deque_##t##_Iterator *it) {                                                                            \
+        dec_deque(it);                                                                                                                          \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_Iterator_deref(Deque_##t##_Iterator *it) {                                                                            \
+        return deref_deque(it);                                                                                                                 \
     }                                                                                                                                           \
     /* Function to construct the Deque List structure for the first time */                                                                     \
-    void Deque_##t##_ctor(Deque_##t *deq, bool (*compare_lists)(const t &o1, const t &o2)) {                                                    \
-        /* Memory allocation for myClass_list with static size */                                                                               \
-        deq->t##_list = new t[LIST_CAPACITY];                                                                                                   \
+    inline void Deque_##t##_ctor(Deque_##t *deq, bool (*compare_lists)(const t &o1, const t &o2)) {                                             \
+        /* Memory allocation for myClass_list with static size (elements are constructed when they are pushed) */                               \
+        /* Small Deque starts with its inline storage and does not allocate */                                                                  \
+        size_t list_capacity = ((inline_n) != 0) ? (inline_n) : LIST_CAPACITY;                                                                  \
+        deq->t##_list = ((inline_n) != 0) ? deq->inline_buffer.data() : deque_allocate<t>(LIST_CAPACITY);                                       \
         /* Logic if Heap memory allocated correctly */                                                                                          \
         if (deq->t##_list != nullptr) {                                                                                                         \
             strcpy(deq->type_name, ("Deque_" #t));                                                                                              \
             deq->list_front_index = 0;                                                                                                          \
-            deq->list_back_index = 0;                                                                                                           \
-            deq->list_capacity = LIST_CAPACITY;                                                                                                 \
+            deq->list_back_index = list_capacity - 1;                                                                                           \
+            deq->list_capacity = list_capacity;                                                                                                 \
+            deq->list_capacity_mask = list_capacity - 1;                                                                                        \
             deq->list_elements = 0;                                                                                                             \
+            deq->list_shrink_threshold = 0;                                                                                                     \
+            deq->growth_policy = DequeGrowthPolicy{DOUBLE, 0, 0, LIST_CAPACITY};                                                                \
+            deq->read_carry_bytes = 0;                                                                                                          \
             /* Initialization of function pointers */                                                                                           \
             deq->size = list_size;                                                                                                              \
             deq->empty = list_empty;                                                                                                            \
             deq->push_back = &push_back_deque;                                                                                                  \
             deq->push_front = &push_front_deque;                                                                                                \
+            deq->push_back_move = &push_back_move_deque;                                                                                        \
+            deq->push_front_move = &push_front_move_deque;                                                                                      \
             deq->pop_back = &pop_back_deque;                                                                                                    \
             deq->pop_front = &pop_front_deque;                                                                                                  \
+            deq->push_back_n = &push_back_n_deque;                                                                                              \
+            deq->push_front_n = &push_front_n_deque;                                                                                            \
+            deq->pop_front_n = &pop_front_n_deque;                                                                                              \
+            deq->copy_out = &copy_out_deque;                                                                                                    \
             deq->front = &front_deque;                                                                                                          \
             deq->back = &back_deque;                                                                                                            \
             deq->at = &at_deque;                                                                                                                \
@@ -290,6 +1130,14 @@
             deq->dtor = &dtor_deque;                                                                                                            \
             deq->compare_elements = compare_lists;                                                                                              \
             deq->sort = sort_list;                                                                                                              \
+            deq->radix_sort = radix_sort_list;                                                                                                  \
+            deq->parallel_sort = parallel_sort_list;                                                                                            \
+            deq->spans = &spans_deque;                                                                                                          \
+            deq->reserve = &reserve_deque;                                                                                                      \
+            deq->shrink_to_fit = &shrink_to_fit_deque;                                                                                          \
+            deq->set_growth_policy = &set_growth_policy_deque;                                                                                  \
+            deq->write_to_fd = &write_to_fd_deque;                                                                                              \
+            deq->read_from_fd = &read_from_fd_deque;                                                                                            \
         }                                                                                                                                       \
     }
 
@@ -5,7 +5,17 @@
 #include <stdint.h>
 #include <random>
 #include <unistd.h>
+#include <fcntl.h>
+#include <string>
 #include "deque.hpp"
+#include "segmented_deque.hpp"
+#include "spsc_deque.hpp"
+#include "mpmc_deque.hpp"
+#include "work_stealing_deque.hpp"
+#include "window_deque.hpp"
+#include <vector>
+#include <thread>
+#include <stdexcept>
 
 /*
  * Test for User Defined class
@@ -24,6 +34,7 @@ void MyClass_print(const MyClass *o) {
     printf("%s\n", o->name);
 }
 Deque_Custom(MyClass)
+Deque_Segmented_Custom(MyClass)
 
 /*
  * Test for Primitive Data Type (int)
@@ -31,7 +42,107 @@ Deque_Custom(MyClass)
 bool int_less(const int &o1, const int &o2) {
     return o1 < o2;
 }
+
+bool int_greater(const int &o1, const int &o2) {
+    return o1 > o2;
+}
+
+// Orders even values before odd values, ascending within each
+bool int_even_first(const int &o1, const int &o2) {
+    return (o1 % 2 != o2 % 2) ? o1 % 2 == 0 : o1 < o2;
+}
 Deque_Custom(int)
+Deque_Segmented_Custom(int)
+Deque_SPSC_Custom(int)
+Deque_MPMC_Custom(int)
+WorkStealingDeque_Custom(int)
+Deque_Window_Custom(int)
+
+/*
+ * Test for class which is not trivially copyable
+ */
+struct Named {
+    int id;
+    std::string name;
+};
+
+bool Named_less_by_id(const Named &o1, const Named &o2) {
+    return o1.id < o2.id;
+}
+Deque_Custom(Named)
+
+/*
+ * Test for class which counts its constructions, copies and destructions
+ */
+struct Tracked {
+    static int live, copies, moves;
+    int id;
+    std::string name;
+
+    Tracked(int new_id, const char *new_name) : id{new_id}, name{new_name} { live++; }
+    Tracked(const Tracked &other) : id{other.id}, name{other.name} { live++; copies++; }
+    Tracked(Tracked &&other) noexcept : id{other.id}, name{std::move(other.name)} { live++; moves++; }
+    Tracked &operator=(const Tracked &other) = default;
+    Tracked &operator=(Tracked &&other) = default;
+    ~Tracked() { live--; }
+};
+int Tracked::live = 0, Tracked::copies = 0, Tracked::moves = 0;
+
+bool Tracked_less_by_id(const Tracked &o1, const Tracked &o2) {
+    return o1.id < o2.id;
+}
+Deque_Custom(Tracked)
+
+/*
+ * Test for class whose move constructor throws once moves_left drops to zero
+ */
+struct ThrowingMove {
+    static int live, moves_left;
+    int id;
+
+    explicit ThrowingMove(int new_id) : id{new_id} { live++; }
+    ThrowingMove(ThrowingMove &&other) : id{other.id} {
+        if (moves_left-- == 0) {
+            throw std::runtime_error("move failed");
+        }
+        live++;
+    }
+    ~ThrowingMove() { live--; }
+};
+int ThrowingMove::live = 0, ThrowingMove::moves_left = -1;
+
+bool string_less(const string &o1, const string &o2) {
+    return o1 < o2;
+}
+Deque_Custom(string)
+
+/*
+ * Test for small deques with inline storage
+ */
+struct Token {
+    int id;
+    std::string text;
+};
+
+bool Token_less_by_id(const Token &o1, const Token &o2) {
+    return o1.id < o2.id;
+}
+Deque_Custom_Small(Token, 4)
+
+struct Point {
+    int x;
+    int y;
+};
+
+bool Point_less_by_x(const Point &o1, const Point &o2) {
+    return o1.x < o2.x;
+}
+Deque_Custom_Small(Point, 8)
+
+bool double_less(const double &o1, const double &o2) {
+    return o1 < o2;
+}
+Deque_Window_Custom(double)
 
 int main() {
     FILE *devnull = fopen("/dev/null", "w");
@@ -155,6 +266,986 @@ int main() {
         }
     }
 
+    /*
+     * Test wraparound and growth of the ring buffer with pushes on both ends.
+     */
+    {
+        Deque_int deq;
+        Deque_int_ctor(&deq, int_less);
+        assert(deq.list_capacity == LIST_CAPACITY);
+
+        for (int i = 0; i < 1000; i++) {
+            deq.push_front(&deq, -i - 1);
+            deq.push_back(&deq, i);
+        }
+        assert(deq.size(&deq) == 2000);
+        assert((deq.list_capacity & deq.list_capacity_mask) == 0);
+        assert(deq.front(&deq) == -1000 && deq.back(&deq) == 999);
+        for (size_t i = 0; i < 2000; i++) {
+            assert(deq.at(&deq, i) == (int) i - 1000);
+        }
+
+        // Rotate the whole content through the wraparound point.
+        for (int i = 0; i < 5000; i++) {
+            int value = deq.front(&deq);
+            deq.pop_front(&deq);
+            deq.push_back(&deq, value);
+        }
+        int expected = -1000 + 5000 % 2000;
+        for (Deque_int_Iterator it = deq.begin(&deq); !Deque_int_Iterator_equal(it, deq.end(&deq)); it.inc(&it)) {
+            assert(it.deref(&it) == expected);
+            expected = (expected == 999) ? -1000 : expected + 1;
+        }
+
+        // Sort a sub range which wraps around the end of the buffer.
+        auto sort_begin = deq.begin(&deq), sort_end = deq.end(&deq);
+        sort_begin.inc(&sort_begin);
+        sort_end.dec(&sort_end);
+        deq.sort(&deq, sort_begin, sort_end);
+        for (size_t i = 2; i < 1999; i++) {
+            assert(deq.at(&deq, i - 1) <= deq.at(&deq, i));
+        }
+        assert(deq.front(&deq) == 0 && deq.back(&deq) == -1);
+
+        while (!deq.empty(&deq)) {
+            deq.pop_back(&deq);
+        }
+        deq.push_back(&deq, 7);
+        assert(deq.front(&deq) == 7 && deq.back(&deq) == 7);
+
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test segmented deque, including stability of element references across growth.
+     */
+    {
+        Deque_MyClass_Segmented deq;
+        Deque_MyClass_Segmented_ctor(&deq, MyClass_less_by_id);
+        assert(deq.empty(&deq));
+        printf("---- %s, %d\n", deq.type_name, (int) sizeof(deq.type_name));
+        assert(sizeof deq.type_name == 24);
+
+        deq.push_back(&deq, MyClass{1, "Joe"});
+        deq.push_front(&deq, MyClass{0, "Mike"});
+        MyClass *first = &deq.front(&deq);
+        for (int i = 2; i < 10000; i++) {
+            deq.push_back(&deq, MyClass{i, "Tom"});
+            deq.push_front(&deq, MyClass{-i, "Mary"});
+        }
+        assert(first->id == 0 && first == &deq.at(&deq, 9998));
+        assert(deq.size(&deq) == 19998);
+        assert(deq.front(&deq).id == -9999 && deq.back(&deq).id == 9999);
+        for (size_t i = 0; i < deq.size(&deq); i++) {
+            int id = deq.at(&deq, i).id;
+            assert(i < 9998 ? id == (int) i - 9999 : id == (int) i - 9998);
+        }
+
+        Deque_MyClass_Segmented_Iterator it = deq.end(&deq);
+        it.dec(&it);
+        assert(it.deref(&it).id == 9999);
+        deq.sort(&deq, deq.begin(&deq), deq.end(&deq));
+        for (size_t i = 1; i < deq.size(&deq); i++) {
+            assert(deq.at(&deq, i - 1).id < deq.at(&deq, i).id);
+        }
+
+        Deque_MyClass_Segmented copy;
+        Deque_MyClass_Segmented_ctor(&copy, MyClass_less_by_id);
+        for (Deque_MyClass_Segmented_Iterator iter = deq.begin(&deq);
+             !Deque_MyClass_Segmented_Iterator_equal(iter, deq.end(&deq)); iter.inc(&iter)) {
+            copy.push_back(&copy, iter.deref(&iter));
+        }
+        assert(Deque_MyClass_Segmented_equal(deq, copy));
+        copy.pop_front(&copy);
+        assert(!Deque_MyClass_Segmented_equal(deq, copy));
+
+        // Alternate pops so that blocks are released from both ends.
+        while (!deq.empty(&deq)) {
+            deq.pop_front(&deq);
+            deq.pop_back(&deq);
+        }
+        assert(deq.block_count == 0);
+        deq.push_front(&deq, MyClass{5, "Joe"});
+        assert(deq.back(&deq).id == 5);
+        deq.clear(&deq);
+        assert(deq.size(&deq) == 0);
+
+        copy.dtor(&copy);
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test direct-call API against the function pointer interface.
+     */
+    {
+        Deque_int deq;
+        Deque_int_ctor(&deq, int_less);
+        for (int i = 0; i < 100; i++) {
+            Deque_int_push_back(&deq, i);
+            Deque_int_push_front(&deq, -i);
+        }
+        assert(Deque_int_size(&deq) == deq.size(&deq) && !Deque_int_empty(&deq));
+        assert(Deque_int_front(&deq) == -99 && Deque_int_back(&deq) == 99);
+        Deque_int_pop_front(&deq);
+        Deque_int_pop_back(&deq);
+        assert(&Deque_int_at(&deq, 5) == &deq.at(&deq, 5));
+        Deque_int_sort(&deq, Deque_int_begin(&deq), Deque_int_end(&deq));
+        Deque_int_Iterator it = Deque_int_end(&deq);
+        Deque_int_Iterator_dec(&it);
+        assert(Deque_int_Iterator_deref(&it) == 98);
+        Deque_int_Iterator_inc(&it);
+        assert(Deque_int_Iterator_equal(it, deq.end(&deq)));
+        Deque_int_clear(&deq);
+        assert(Deque_int_empty(&deq));
+        Deque_int_dtor(&deq);
+
+        Deque_int_Segmented seg;
+        Deque_int_Segmented_ctor(&seg, int_less);
+        for (int i = 0; i < 1000; i++) {
+            Deque_int_Segmented_push_front(&seg, i);
+        }
+        assert(Deque_int_Segmented_at(&seg, 0) == 999 && Deque_int_Segmented_back(&seg) == 0);
+        Deque_int_Segmented_dtor(&seg);
+    }
+
+    /*
+     * Test bulk push/pop and range copy in bursts which wrap around the ring buffer.
+     */
+    {
+        Deque_int deq;
+        Deque_int_ctor(&deq, int_less);
+        int burst[256], drained[256];
+        int next_in = 0, next_out = 0;
+        for (int round = 0; round < 50; round++) {
+            for (int i = 0; i < 256; i++) {
+                burst[i] = next_in++;
+            }
+            deq.push_back_n(&deq, burst, 256);
+            size_t copied = deq.copy_out(&deq, drained, 200);
+            assert(copied == 200);
+            deq.pop_front_n(&deq, copied);
+            for (int i = 0; i < 200; i++) {
+                assert(drained[i] == next_out++);
+            }
+        }
+        assert(deq.size(&deq) == 50 * 56 && deq.front(&deq) == next_out);
+
+        int front_burst[3] = {-3, -2, -1};
+        deq.push_front_n(&deq, front_burst, 3);
+        assert(deq.front(&deq) == -3 && deq.at(&deq, 2) == -1 && deq.at(&deq, 3) == next_out);
+        deq.pop_back(&deq);
+        assert(deq.back(&deq) == next_in - 2);
+
+        // Draining more than the size stops at the size.
+        size_t remaining = deq.size(&deq);
+        int *rest = new int[remaining + 10];
+        assert(Deque_int_copy_out(&deq, rest, remaining + 10) == remaining);
+        assert(rest[0] == -3 && rest[remaining - 1] == next_in - 2);
+        Deque_int_pop_front_n(&deq, remaining + 10);
+        assert(deq.empty(&deq));
+        delete[] rest;
+
+        // Bulk push into a fresh deque which needs several doublings at once.
+        int *many = new int[1000];
+        for (int i = 0; i < 1000; i++) {
+            many[i] = i;
+        }
+        Deque_int_push_front_n(&deq, many, 1000);
+        Deque_int_push_back_n(&deq, many, 1000);
+        assert(deq.size(&deq) == 2000 && deq.at(&deq, 999) == 999 && deq.at(&deq, 1000) == 0);
+        delete[] many;
+        deq.dtor(&deq);
+
+        Deque_Named named;
+        Deque_Named_ctor(&named, Named_less_by_id);
+        Named people[3] = {{1, "Joe"}, {2, "a name too long for small string storage"}, {3, "Tom"}};
+        named.push_back_n(&named, people, 3);
+        named.push_front_n(&named, people, 3);
+        Named copies[6];
+        assert(named.copy_out(&named, copies, 6) == 6);
+        assert(copies[1].name == people[1].name && copies[4].name == people[1].name && copies[5].id == 3);
+        named.pop_front_n(&named, 4);
+        assert(named.front(&named).name == people[1].name && named.size(&named) == 2);
+        named.dtor(&named);
+    }
+
+    /*
+     * Test single producer single consumer deque with one thread on each side.
+     */
+    {
+        Deque_int_SPSC deq;
+        Deque_int_SPSC_ctor(&deq, 100);
+        assert(deq.list_capacity == 128 && deq.empty(&deq));
+
+        // Fill up and drain on one thread.
+        int values[200], out = 0;
+        for (int i = 0; i < 200; i++) {
+            values[i] = i;
+        }
+        assert(deq.try_push_back_n(&deq, values, 200) == 128);
+        assert(!deq.try_push_back(&deq, 0) && deq.size(&deq) == 128);
+        assert(deq.try_pop_front(&deq, &out) && out == 0);
+        assert(deq.try_push_back(&deq, 128));
+        assert(Deque_int_SPSC_try_pop_front_n(&deq, values, 200) == 128);
+        assert(values[0] == 1 && values[127] == 128 && deq.empty(&deq));
+        assert(!Deque_int_SPSC_try_pop_front(&deq, &out));
+
+        const int total = 1000000;
+        std::thread producer([&deq]() {
+            int burst[37];
+            int next = 0;
+            while (next < total) {
+                // Alternate single pushes with batches which wrap around the ring
+                if (next % 2 == 0) {
+                    if (Deque_int_SPSC_try_push_back(&deq, next)) {
+                        next++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                } else {
+                    int count = std::min(37, total - next);
+                    for (int i = 0; i < count; i++) {
+                        burst[i] = next + i;
+                    }
+                    size_t pushed = Deque_int_SPSC_try_push_back_n(&deq, burst, count);
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                    next += (int) pushed;
+                }
+            }
+        });
+        int expected = 0, received[64];
+        while (expected < total) {
+            size_t count = Deque_int_SPSC_try_pop_front_n(&deq, received, 64);
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < count; i++) {
+                assert(received[i] == expected++);
+            }
+        }
+        producer.join();
+        assert(deq.empty(&deq));
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test multi producer multi consumer deque, blocking calls park threads on the tiny ring.
+     */
+    {
+        Deque_int_MPMC deq;
+        Deque_int_MPMC_ctor(&deq, 2);
+        assert(deq.list_capacity == LIST_CAPACITY && deq.empty(&deq));
+
+        int out = 0;
+        for (int i = 0; i < LIST_CAPACITY; i++) {
+            assert(deq.try_push_back(&deq, i));
+        }
+        assert(!deq.try_push_back(&deq, -1) && deq.size(&deq) == LIST_CAPACITY);
+        for (int i = 0; i < LIST_CAPACITY; i++) {
+            assert(deq.try_pop_front(&deq, &out) && out == i);
+        }
+        assert(!Deque_int_MPMC_try_pop_front(&deq, &out) && deq.empty(&deq));
+
+        const int threads = 4, per_thread = 50000;
+        std::atomic<long long> consumed_sum(0);
+        std::atomic<int> consumed_count(0);
+        std::thread producers[threads], consumers[threads];
+        for (int p = 0; p < threads; p++) {
+            producers[p] = std::thread([&deq, p]() {
+                for (int i = 0; i < per_thread; i++) {
+                    Deque_int_MPMC_push_back(&deq, p * per_thread + i);
+                }
+            });
+        }
+        for (int c = 0; c < threads; c++) {
+            consumers[c] = std::thread([&]() {
+                int value, last_seen[threads];
+                for (int p = 0; p < threads; p++) {
+                    last_seen[p] = -1;
+                }
+                for (int i = 0; i < per_thread; i++) {
+                    Deque_int_MPMC_pop_front(&deq, &value);
+                    // Elements of one producer are consumed in the order they were pushed
+                    assert(value % per_thread > last_seen[value / per_thread]);
+                    last_seen[value / per_thread] = value % per_thread;
+                    consumed_sum += value;
+                    consumed_count++;
+                }
+            });
+        }
+        for (int i = 0; i < threads; i++) {
+            producers[i].join();
+            consumers[i].join();
+        }
+        long long n = (long long) threads * per_thread;
+        assert(consumed_count == n && consumed_sum == n * (n - 1) / 2);
+        assert(deq.empty(&deq));
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test work stealing deque, owner works at the back while thieves steal from the front during growth.
+     */
+    {
+        WorkStealingDeque_int deq;
+        WorkStealingDeque_int_ctor(&deq);
+        int value = 0;
+        assert(deq.empty(&deq) && !deq.pop_back(&deq, &value) && !deq.steal_front(&deq, &value));
+        for (int i = 0; i < 100; i++) {
+            deq.push_back(&deq, i);
+        }
+        assert(deq.size(&deq) == 100);
+        assert(deq.pop_back(&deq, &value) && value == 99);
+        assert(deq.steal_front(&deq, &value) && value == 0);
+        while (WorkStealingDeque_int_pop_back(&deq, &value)) {
+        }
+        assert(value == 1 && deq.empty(&deq));
+
+        const int total = 200000, thieves = 3;
+        std::vector<std::atomic<int>> taken(total);
+        std::atomic<bool> done(false);
+        std::vector<std::thread> thief_threads;
+        for (int i = 0; i < thieves; i++) {
+            thief_threads.emplace_back([&]() {
+                int stolen;
+                while (!done.load()) {
+                    if (WorkStealingDeque_int_steal_front(&deq, &stolen)) {
+                        taken[stolen]++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < total; i++) {
+            WorkStealingDeque_int_push_back(&deq, i);
+            // Owner keeps part of the work for itself
+            if (i % 3 == 0 && WorkStealingDeque_int_pop_back(&deq, &value)) {
+                taken[value]++;
+            }
+        }
+        while (WorkStealingDeque_int_pop_back(&deq, &value)) {
+            taken[value]++;
+        }
+        done = true;
+        for (auto &thief : thief_threads) {
+            thief.join();
+        }
+        for (int i = 0; i < total; i++) {
+            assert(taken[i] == 1);
+        }
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test in place sort and radix sort on ranges which wrap around the ring buffer.
+     */
+    {
+        std::mt19937 engine(7);
+        Deque_int deq, expected;
+        Deque_int_ctor(&deq, int_less);
+        Deque_int_ctor(&expected, int_less);
+        for (int round = 0; round < 2; round++) {
+            for (int i = 0; i < 100000; i++) {
+                int value = (int) (engine() % 2000000001u) - 1000000000;
+                // Push on both ends so that the elements wrap around the buffer
+                if (i % 2 == 0) {
+                    deq.push_back(&deq, value);
+                } else {
+                    deq.push_front(&deq, value);
+                }
+            }
+            for (int i = 0; i < 1000; i++) {
+                deq.push_back(&deq, i % 10);
+            }
+            for (size_t i = 0; i < deq.size(&deq); i++) {
+                expected.push_back(&expected, deq.at(&deq, i));
+            }
+            std::sort(Deque_int_ring_begin(&expected), Deque_int_ring_end(&expected));
+            assert(std::is_sorted(Deque_int_ring_begin(&expected), Deque_int_ring_end(&expected)));
+            if (round == 0) {
+                deq.sort(&deq, deq.begin(&deq), deq.end(&deq));
+            } else {
+                deq.radix_sort(&deq, deq.begin(&deq), deq.end(&deq));
+            }
+            assert(Deque_int_equal(deq, expected));
+            deq.clear(&deq);
+            expected.clear(&expected);
+        }
+
+        // Radix sort of a sub range leaves the other elements alone
+        for (int i = 0; i < 300; i++) {
+            deq.push_front(&deq, i);
+        }
+        Deque_int_Iterator sub_begin = deq.begin(&deq), sub_end = deq.end(&deq);
+        for (int i = 0; i < 100; i++) {
+            sub_begin.inc(&sub_begin);
+            sub_end.dec(&sub_end);
+        }
+        deq.radix_sort(&deq, sub_begin, sub_end);
+        for (size_t i = 0; i < 300; i++) {
+            int value = deq.at(&deq, i);
+            assert(i < 100 || i >= 200 ? value == 299 - (int) i : value == (int) i);
+        }
+        deq.dtor(&deq);
+        expected.dtor(&expected);
+
+        // Radix sort of integral type keeps the order of a custom compare function
+        for (bool (*compare)(const int &, const int &) : {int_greater, int_even_first}) {
+            Deque_int custom;
+            Deque_int_ctor(&custom, compare);
+            for (int i = 0; i < 1000; i++) {
+                custom.push_back(&custom, (i * 7919) % 1000);
+            }
+            custom.radix_sort(&custom, custom.begin(&custom), custom.end(&custom));
+            assert(std::is_sorted(Deque_int_ring_begin(&custom), Deque_int_ring_end(&custom), compare));
+            assert(custom.size(&custom) == 1000);
+            custom.dtor(&custom);
+        }
+
+        // Radix sort of type without digits uses compare function
+        Deque_MyClass people;
+        Deque_MyClass_ctor(&people, MyClass_less_by_id);
+        for (int i = 0; i < 100; i++) {
+            people.push_front(&people, MyClass{i, "Joe"});
+        }
+        people.radix_sort(&people, people.begin(&people), people.end(&people));
+        assert(people.front(&people).id == 0 && people.back(&people).id == 99);
+        people.dtor(&people);
+    }
+
+    /*
+     * Test parallel sort with a user compare function, including thread counts which do not divide the size.
+     */
+    {
+        std::mt19937 engine(11);
+        Deque_MyClass deq;
+        Deque_MyClass_ctor(&deq, MyClass_less_by_id);
+        for (unsigned threads : {0u, 1u, 3u, 4u, 7u}) {
+            for (int i = 0; i < 200003; i++) {
+                MyClass value{(int) (engine() % 100000), "Joe"};
+                if (i % 2 == 0) {
+                    deq.push_back(&deq, value);
+                } else {
+                    deq.push_front(&deq, value);
+                }
+            }
+            long long id_sum = 0;
+            for (size_t i = 0; i < deq.size(&deq); i++) {
+                id_sum += deq.at(&deq, i).id;
+            }
+            deq.parallel_sort(&deq, deq.begin(&deq), deq.end(&deq), threads);
+            for (size_t i = 1; i < deq.size(&deq); i++) {
+                assert(deq.at(&deq, i - 1).id <= deq.at(&deq, i).id);
+                id_sum -= deq.at(&deq, i).id;
+            }
+            assert(id_sum == deq.front(&deq).id);
+            deq.clear(&deq);
+        }
+        for (int i = 0; i < 10; i++) {
+            deq.push_front(&deq, MyClass{i, "Tom"});
+        }
+        Deque_MyClass_parallel_sort(&deq, deq.begin(&deq), deq.end(&deq), 4);
+        assert(deq.front(&deq).id == 0 && deq.back(&deq).id == 9);
+        deq.dtor(&deq);
+
+        // Merge split by co-ranking matches a sequential merge for skewed runs and runs of equal keys
+        for (size_t left_count : {(size_t) 1, (size_t) 1000, (size_t) 100000}) {
+            for (int key_range : {1, 3, 1000000}) {
+                std::vector<std::string> merged(left_count + 150001), expected;
+                for (size_t i = 0; i < merged.size(); i++) {
+                    merged[i] = std::to_string(100000000 + engine() % key_range) + (i < left_count ? "l" : "r");
+                }
+                auto less_key = [](const std::string &o1, const std::string &o2) {
+                    return o1.compare(0, 9, o2, 0, 9) < 0;
+                };
+                std::sort(merged.begin(), merged.begin() + left_count, less_key);
+                std::sort(merged.begin() + left_count, merged.end(), less_key);
+                expected = merged;
+                std::inplace_merge(expected.begin(), expected.begin() + left_count, expected.end(), less_key);
+                deque_parallel_merge(merged.data(), merged.data() + left_count, merged.data() + merged.size(), less_key, 5);
+                assert(merged == expected);
+            }
+        }
+
+        // Throwing move while merging destroys the elements already moved into the output
+        {
+            std::vector<ThrowingMove> runs;
+            runs.reserve(8);
+            for (int id : {1, 4, 6, 7, 2, 3, 5, 8}) {
+                runs.emplace_back(id);
+            }
+            auto less_id = [](const ThrowingMove &o1, const ThrowingMove &o2) { return o1.id < o2.id; };
+            ThrowingMove *output = deque_allocate<ThrowingMove>(8);
+            ThrowingMove::moves_left = 5;
+            try {
+                deque_merge_relocate(runs.data(), runs.data() + 4, runs.data() + 4, runs.data() + 8, output, less_id);
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingMove::moves_left = -1;
+            assert(ThrowingMove::live == 8);
+            deque_deallocate(output, 8);
+        }
+        assert(ThrowingMove::live == 0);
+    }
+
+    /*
+     * Test spans and scatter/gather I/O through a pipe, with the data wrapped around the end of the buffer.
+     */
+    {
+        int pipe_fds[2];
+        assert(pipe(pipe_fds) == 0);
+        Deque_int deq, read_deq;
+        Deque_int_ctor(&deq, int_less);
+        Deque_int_ctor(&read_deq, int_less);
+        DequeSpan<int> spans[2];
+        assert(deq.spans(&deq, spans) == 0);
+        for (int i = 0; i < 20; i++) {
+            deq.push_back(&deq, i);
+        }
+        assert(deq.spans(&deq, spans) == 1 && spans[0].count == 20 && spans[0].data[19] == 19);
+        for (int i = 1; i <= 10; i++) {
+            deq.push_front(&deq, -i);
+        }
+        assert(Deque_int_spans(&deq, spans) == 2 && spans[0].count == 10 && spans[1].count == 20);
+        assert(spans[0].data[0] == -10 && spans[1].data[0] == 0);
+
+        assert(deq.write_to_fd(&deq, pipe_fds[1]) == (ssize_t) (30 * sizeof(int)));
+        assert(deq.size(&deq) == 30);
+        // Free slots of read_deq wrap as well, only whole elements are pushed
+        for (int i = 0; i < 28; i++) {
+            read_deq.push_back(&read_deq, 100);
+        }
+        read_deq.pop_front_n(&read_deq, 28);
+        assert(read_deq.read_from_fd(&read_deq, pipe_fds[0], 20) == 20);
+        assert(Deque_int_read_from_fd(&read_deq, pipe_fds[0], 100) == 10);
+        assert(Deque_int_equal(deq, read_deq));
+
+        int partial_value = 7;
+        assert(write(pipe_fds[1], &partial_value, sizeof(int)) == (ssize_t) sizeof(int));
+        assert(write(pipe_fds[1], &partial_value, 2) == 2);
+        close(pipe_fds[1]);
+        assert(read_deq.read_from_fd(&read_deq, pipe_fds[0], 100) == 1);
+        assert(read_deq.size(&read_deq) == 31 && read_deq.back(&read_deq) == 7);
+        assert(read_deq.read_from_fd(&read_deq, pipe_fds[0], 100) == 0);
+        close(pipe_fds[0]);
+        assert(read_deq.read_from_fd(&read_deq, pipe_fds[0], 100) == -1 && errno == EBADF);
+
+        // Element split across reads of a non-blocking pipe is completed by the next read
+        Deque_int split_deq;
+        Deque_int_ctor(&split_deq, int_less);
+        assert(pipe(pipe_fds) == 0);
+        assert(fcntl(pipe_fds[0], F_SETFL, O_NONBLOCK) == 0);
+        int split_values[2] = {0x01020304, -5};
+        const char *split_bytes = (const char *) split_values;
+        assert(write(pipe_fds[1], split_bytes, 3) == 3);
+        assert(split_deq.read_from_fd(&split_deq, pipe_fds[0], 10) == 0 && split_deq.empty(&split_deq));
+        assert(split_deq.read_from_fd(&split_deq, pipe_fds[0], 10) == -1 && errno == EAGAIN);
+        assert(write(pipe_fds[1], split_bytes + 3, 3) == 3);
+        assert(split_deq.read_from_fd(&split_deq, pipe_fds[0], 10) == 1 && split_deq.front(&split_deq) == split_values[0]);
+        assert(write(pipe_fds[1], split_bytes + 6, 2) == 2);
+        close(pipe_fds[1]);
+        assert(split_deq.read_from_fd(&split_deq, pipe_fds[0], 10) == 1 && split_deq.back(&split_deq) == split_values[1]);
+        assert(split_deq.read_from_fd(&split_deq, pipe_fds[0], 10) == 0 && split_deq.size(&split_deq) == 2);
+        close(pipe_fds[0]);
+        split_deq.dtor(&split_deq);
+
+        // Elements which are not trivially copyable are refused
+        Deque_Named named_deq;
+        Deque_Named_ctor(&named_deq, Named_less_by_id);
+        named_deq.push_back(&named_deq, Named{1, "Joe"});
+        assert(named_deq.write_to_fd(&named_deq, fileno(devnull)) == -1 && errno == EINVAL);
+        named_deq.dtor(&named_deq);
+        read_deq.dtor(&read_deq);
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test spill mode of segmented deque, middle blocks go to the spill file and come back when an end reaches them.
+     */
+    {
+        Deque_int_Segmented deq;
+        Deque_int_Segmented_ctor(&deq, int_less);
+        for (int i = 0; i < 1000; i++) {
+            deq.push_back(&deq, i);
+        }
+        // Budget of 4 blocks (smallest one), blocks already present are spilled right away
+        assert(deq.spill_to(&deq, "/tmp/deque_spill_test", 1) == 0);
+        assert(access("/tmp/deque_spill_test", F_OK) != 0);
+        assert(deq.spill_to(&deq, "/tmp/deque_spill_test", 1) == -1 && errno == EBUSY);
+        assert(deq.front_resident_blocks + deq.back_resident_blocks == SPILL_MIN_BLOCKS);
+        for (int i = 1000; i < 20000; i++) {
+            deq.push_back(&deq, i);
+            assert(deq.front_resident_blocks + deq.back_resident_blocks <= SPILL_MIN_BLOCKS);
+        }
+        for (int i = 1; i <= 5000; i++) {
+            deq.push_front(&deq, -i);
+        }
+        assert(deq.front_resident_blocks + deq.back_resident_blocks == SPILL_MIN_BLOCKS);
+        assert(deq.block_count > 300);
+
+        // Random access and writes through the cache block
+        for (size_t i = 0; i < deq.size(&deq); i += 97) {
+            assert(deq.at(&deq, i) == (int) i - 5000);
+        }
+        deq.at(&deq, 10000) = 123456;
+        deq.at(&deq, 20000) = 654321;
+        assert(deq.at(&deq, 10000) == 123456 && Deque_int_Segmented_at(&deq, 20000) == 654321);
+        deq.at(&deq, 10000) = 5000;
+        deq.at(&deq, 20000) = 15000;
+
+        // Popping from both ends pages middle blocks back in order
+        for (int i = -5000; i < 10000; i++) {
+            assert(deq.front(&deq) == i);
+            deq.pop_front(&deq);
+        }
+        for (int i = 19999; i >= 12000; i--) {
+            assert(deq.back(&deq) == i);
+            deq.pop_back(&deq);
+        }
+        assert(deq.size(&deq) == 2000 && deq.front(&deq) == 10000 && deq.back(&deq) == 11999);
+
+        // Sorting spilled blocks
+        for (int i = 0; i < 10000; i++) {
+            deq.push_back(&deq, (i * 7919) % 10000);
+        }
+        deq.sort(&deq, deq.begin(&deq), deq.end(&deq));
+        for (size_t i = 1; i < deq.size(&deq); i++) {
+            assert(deq.at(&deq, i - 1) <= deq.at(&deq, i));
+        }
+        deq.clear(&deq);
+        assert(deq.empty(&deq) && deq.spill_slot_end == 0);
+        for (int i = 0; i < 1000; i++) {
+            deq.push_front(&deq, i);
+        }
+        for (int i = 999; i >= 0; i--) {
+            assert(deq.front(&deq) == i);
+            deq.pop_front(&deq);
+        }
+        deq.dtor(&deq);
+
+        // Comparing spilled deques reads through their own cache blocks and leaves them valid
+        Deque_int_Segmented spilled[2];
+        for (Deque_int_Segmented &side : spilled) {
+            Deque_int_Segmented_ctor(&side, int_less);
+            for (int i = 0; i < 1280; i++) {
+                side.push_back(&side, i);
+            }
+            assert(side.spill_to(&side, "/tmp/deque_spill_test", 1) == 0);
+        }
+        assert(spilled[0].at(&spilled[0], 513) == 513 && spilled[1].at(&spilled[1], 1089) == 1089);
+        assert(Deque_int_Segmented_equal(spilled[0], spilled[1]));
+        spilled[0].at(&spilled[0], 600) = -600;
+        assert(!Deque_int_Segmented_equal(spilled[0], spilled[1]));
+        spilled[0].at(&spilled[0], 600) = 600;
+        for (Deque_int_Segmented &side : spilled) {
+            for (int i = 0; i < 1280; i++) {
+                assert(side.at(&side, i) == i);
+            }
+            for (int i = 0; i < 1280; i++) {
+                assert(side.front(&side) == i);
+                side.pop_front(&side);
+            }
+            side.dtor(&side);
+        }
+    }
+
+    /*
+     * Test reserve, shrink_to_fit and growth policy of deque.
+     */
+    {
+        Deque_int deq;
+        Deque_int_ctor(&deq, int_less);
+        // Default policy doubles and keeps the peak capacity
+        for (int i = 0; i < 1000; i++) {
+            deq.push_back(&deq, i);
+        }
+        assert(deq.list_capacity == 1024);
+        deq.pop_front_n(&deq, 990);
+        deq.clear(&deq);
+        assert(deq.list_capacity == 1024);
+        deq.shrink_to_fit(&deq);
+        assert(deq.list_capacity == LIST_CAPACITY);
+
+        // Reserved buffer is not reallocated by pushes at both ends
+        Deque_int_reserve(&deq, 3000);
+        assert(deq.list_capacity == 4096);
+        int *reserved_list = deq.int_list;
+        for (int i = 0; i < 2000; i++) {
+            deq.push_back(&deq, i);
+            deq.push_front(&deq, -i - 1);
+        }
+        assert(deq.int_list == reserved_list);
+        deq.reserve(&deq, 10);
+        assert(deq.list_capacity == 4096);
+        deq.pop_front_n(&deq, 1990);
+        Deque_int_shrink_to_fit(&deq);
+        assert(deq.list_capacity == 2048 && deq.size(&deq) == 2010);
+        for (int i = -10; i < 2000; i++) {
+            assert(deq.at(&deq, i + 10) == i);
+        }
+        deq.clear(&deq);
+        deq.shrink_to_fit(&deq);
+
+        // Factor 4 up to capacity 256, then doubling
+        deq.set_growth_policy(&deq, DequeGrowthPolicy{3, 256, 0, 0});
+        assert(deq.growth_policy.growth_factor == 4 && deq.growth_policy.min_capacity == LIST_CAPACITY);
+        size_t expected_capacities[] = {128, 512, 1024};
+        for (size_t expected_capacity : expected_capacities) {
+            while (deq.size(&deq) < deq.list_capacity) {
+                deq.push_back(&deq, 1);
+            }
+            deq.push_back(&deq, 1);
+            assert(deq.list_capacity == expected_capacity);
+        }
+        deq.clear(&deq);
+
+        // Shrinking with hysteresis, elements stay in order while the buffer wraps
+        Deque_int_set_growth_policy(&deq, DequeGrowthPolicy{2, 0, 4, 64});
+        for (int i = 0; i < 10000; i++) {
+            deq.push_back(&deq, i);
+        }
+        assert(deq.list_capacity == 16384);
+        int front_value = 0;
+        size_t peak_capacity = deq.list_capacity;
+        while (deq.size(&deq) > 100) {
+            assert(deq.front(&deq) == front_value++);
+            deq.pop_front(&deq);
+            deq.push_back(&deq, front_value + (int) deq.size(&deq));
+            deq.pop_back(&deq);
+            assert(deq.size(&deq) >= deq.list_capacity / 4 || deq.list_capacity == 64);
+            assert(deq.list_capacity <= peak_capacity);
+            peak_capacity = deq.list_capacity;
+        }
+        assert(deq.list_capacity == 256);
+        for (int i = 0; i < 100; i++) {
+            assert(deq.at(&deq, i) == front_value + i);
+        }
+        deq.clear(&deq);
+        assert(deq.list_capacity == 64);
+        deq.dtor(&deq);
+    }
+
+    /*
+     * Test element lifetimes of deque, only pushed elements are constructed and growth moves them.
+     */
+    {
+        Deque_Tracked deq;
+        Deque_Tracked_ctor(&deq, Tracked_less_by_id);
+        assert(Tracked::live == 0);
+        for (int i = 0; i < 1000; i++) {
+            if (i % 2 == 0) {
+                Deque_Tracked_emplace_back(&deq, i, "a rather long name which is stored on the heap");
+            } else {
+                Deque_Tracked_emplace_front(&deq, -i, "another rather long name stored on the heap");
+            }
+        }
+        assert(Tracked::live == 1000 && Tracked::copies == 0 && Tracked::moves > 0);
+        int moves = Tracked::moves;
+        deq.push_back_move(&deq, Tracked{1000, "moved"});
+        Deque_Tracked_push_front_move(&deq, Tracked{-1000, "moved"});
+        assert(Tracked::copies == 0 && Tracked::moves == moves + 2 && Tracked::live == 1002);
+        // Copying push and emplace of an element of the deque itself while the buffer grows
+        while (deq.size(&deq) < deq.list_capacity) {
+            Deque_Tracked_emplace_back(&deq, 0, "filler");
+        }
+        deq.push_back(&deq, deq.front(&deq));
+        assert(Tracked::copies == 1 && deq.back(&deq).id == -1000 && deq.back(&deq).name == "moved");
+        // Direct call API forwards its by value argument without another copy
+        Deque_Tracked_push_back(&deq, deq.front(&deq));
+        Deque_Tracked_push_front(&deq, Tracked{-1001, "temporary"});
+        assert(Tracked::copies == 2 && deq.back(&deq).id == -1000 && deq.front(&deq).id == -1001);
+        while (deq.size(&deq) < deq.list_capacity) {
+            Deque_Tracked_emplace_back(&deq, 0, "filler");
+        }
+        Deque_Tracked_emplace_front(&deq, deq.back(&deq));
+        assert(deq.front(&deq).name == "filler");
+
+        deq.pop_front(&deq);
+        deq.pop_back(&deq);
+        deq.pop_front_n(&deq, 10);
+        assert(Tracked::live == (int) deq.size(&deq));
+        deq.sort(&deq, deq.begin(&deq), deq.end(&deq));
+        deq.shrink_to_fit(&deq);
+        assert(Tracked::live == (int) deq.size(&deq));
+        deq.clear(&deq);
+        assert(Tracked::live == 0);
+        deq.push_back(&deq, Tracked{1, "last"});
+        deq.dtor(&deq);
+        assert(Tracked::live == 0);
+
+        Deque_string strings;
+        Deque_string_ctor(&strings, string_less);
+        for (int i = 0; i < 100; i++) {
+            Deque_string_emplace_front(&strings, (size_t) 20 + i % 7, (char) ('a' + i % 26));
+            strings.push_back_move(&strings, std::to_string(i));
+        }
+        strings.sort(&strings, strings.begin(&strings), strings.end(&strings));
+        assert(strings.front(&strings) == "0" && strings.back(&strings) == std::string(24, 'z'));
+        strings.dtor(&strings);
+
+        // Wrapped buffers are linearized in place for every split of elements around the end of the buffer
+        for (size_t count : {(size_t) 1, (size_t) 6, (size_t) 16, (size_t) 26, (size_t) LIST_CAPACITY - 1, (size_t) LIST_CAPACITY}) {
+            for (size_t shift = 1; shift < LIST_CAPACITY; shift += 3) {
+                Deque_Tracked wrapped;
+                Deque_Tracked_ctor(&wrapped, Tracked_less_by_id);
+                for (size_t i = 0; i < shift; i++) {
+                    Deque_Tracked_emplace_back(&wrapped, 0, "popped");
+                }
+                wrapped.pop_front_n(&wrapped, shift);
+                for (size_t i = 0; i < count; i++) {
+                    Deque_Tracked_emplace_back(&wrapped, (int) ((i * 7) % count), "a rather long name which is stored on the heap");
+                }
+                int copies = Tracked::copies;
+                wrapped.sort(&wrapped, wrapped.begin(&wrapped), wrapped.end(&wrapped));
+                assert(wrapped.list_capacity == LIST_CAPACITY && Tracked::copies == copies);
+                assert(Tracked::live == (int) count && wrapped.size(&wrapped) == count);
+                for (size_t i = 1; i < count; i++) {
+                    assert(wrapped.at(&wrapped, i - 1).id <= wrapped.at(&wrapped, i).id);
+                    assert(wrapped.at(&wrapped, i).name == "a rather long name which is stored on the heap");
+                }
+                wrapped.dtor(&wrapped);
+            }
+        }
+        assert(Tracked::live == 0);
+
+        // Full buffer wrapped by a single front element has no free slot to move the front run through
+        Deque_string full;
+        Deque_string_ctor(&full, string_less);
+        for (int i = 0; i < LIST_CAPACITY - 1; i++) {
+            full.push_back(&full, std::string(30, (char) ('b' + i % 20)));
+        }
+        full.push_front(&full, std::string(30, 'a'));
+        assert(full.size(&full) == full.list_capacity && full.list_front_index == LIST_CAPACITY - 1);
+        full.sort(&full, full.begin(&full), full.end(&full));
+        assert(full.front(&full) == std::string(30, 'a') && full.list_front_index == 0);
+        for (size_t i = 1; i < full.size(&full); i++) {
+            assert(full.at(&full, i - 1) <= full.at(&full, i) && full.at(&full, i).size() == 30);
+        }
+        full.dtor(&full);
+    }
+
+    /*
+     * Test small deques, elements stay inside the structure until they overflow the inline storage.
+     */
+    {
+        Deque_Token deq;
+        Deque_Token_ctor(&deq, Token_less_by_id);
+        assert(deq.Token_list == deq.inline_buffer.data() && deq.list_capacity == 4);
+        // Wrapped inline storage, sorting linearizes the elements in place
+        deq.push_back(&deq, Token{3, "a string long enough to live on the heap"});
+        Deque_Token_emplace_front(&deq, Token{1, "one"});
+        deq.push_front(&deq, Token{4, "four"});
+        deq.push_back(&deq, Token{2, "two"});
+        assert(deq.Token_list == deq.inline_buffer.data() && deq.list_front_index != 0);
+        deq.sort(&deq, deq.begin(&deq), deq.end(&deq));
+        for (int i = 0; i < 4; i++) {
+            assert(deq.at(&deq, i).id == i + 1);
+        }
+        assert(deq.at(&deq, 2).text == "a string long enough to live on the heap");
+
+        // Overflow moves the elements to a regular heap buffer, shrinking brings them back
+        deq.push_back(&deq, Token{5, "five"});
+        assert(deq.Token_list != deq.inline_buffer.data() && deq.list_capacity == LIST_CAPACITY);
+        for (int i = 6; i <= 100; i++) {
+            deq.push_back(&deq, Token{i, std::to_string(i)});
+        }
+        deq.pop_front_n(&deq, 97);
+        deq.shrink_to_fit(&deq);
+        assert(deq.Token_list == deq.inline_buffer.data() && deq.list_capacity == 4);
+        assert(deq.size(&deq) == 3 && deq.front(&deq).text == "98" && deq.back(&deq).text == "100");
+        deq.reserve(&deq, 2);
+        assert(deq.Token_list == deq.inline_buffer.data());
+
+        // Automatic shrinking also returns to the inline storage
+        deq.set_growth_policy(&deq, DequeGrowthPolicy{2, 0, 4, 0});
+        for (int i = 0; i < 1000; i++) {
+            deq.push_front(&deq, Token{-i, "front"});
+        }
+        while (deq.size(&deq) > 1) {
+            deq.pop_front(&deq);
+        }
+        assert(deq.Token_list == deq.inline_buffer.data() && deq.front(&deq).id == 100);
+        deq.dtor(&deq);
+
+        Deque_Point points;
+        Deque_Point_ctor(&points, Point_less_by_x);
+        for (int i = 0; i < 8; i++) {
+            points.push_front(&points, Point{i, -i});
+        }
+        points.pop_back(&points);
+        points.push_back(&points, Point{100, 0});
+        assert(points.Point_list == points.inline_buffer.data());
+        points.sort(&points, points.begin(&points), points.end(&points));
+        assert(points.front(&points).x == 1 && points.back(&points).x == 100);
+        Deque_Point_dtor(&points);
+    }
+
+    /*
+     * Test sliding window min, max and sum against scanning the samples, with count and time expiry.
+     */
+    {
+        std::mt19937 engine(5);
+        const size_t max_samples = 50;
+        const long long max_age = 300;
+        Deque_int_Window win;
+        Deque_int_Window_ctor(&win, max_samples, max_age, int_less);
+        std::vector<std::pair<int, long long>> samples;
+        long long time = 0;
+        for (int i = 0; i < 20000; i++) {
+            // Bursts of samples with equal time stamps, pauses which expire the whole window and runs of equal values
+            time += (i % 1000 < 900) ? (long long) (engine() % 3) : (long long) (engine() % 400);
+            int value = (i % 500 < 50) ? 7 : (int) (engine() % 1000) - 500;
+            if (i % 2 == 0) {
+                win.push(&win, value, time);
+            } else {
+                Deque_int_Window_push(&win, value, time);
+            }
+            samples.push_back(std::make_pair(value, time));
+            size_t first = samples.size() > max_samples ? samples.size() - max_samples : 0;
+            while (time - samples[first].second >= max_age) {
+                first++;
+            }
+            int min_value = samples[first].first, max_value = samples[first].first;
+            long long sum = 0;
+            for (size_t j = first; j < samples.size(); j++) {
+                min_value = std::min(min_value, samples[j].first);
+                max_value = std::max(max_value, samples[j].first);
+                sum += samples[j].first;
+            }
+            assert(win.size(&win) == samples.size() - first);
+            assert(win.min(&win) == min_value && Deque_int_Window_max(&win) == max_value);
+            assert(win.sum(&win) == sum && Deque_int_Window_sum(&win) == sum);
+        }
+        // Expiry without new samples
+        win.expire(&win, time + max_age - 1);
+        assert(!win.empty(&win));
+        Deque_int_Window_expire(&win, time + max_age);
+        assert(win.empty(&win) && win.sum(&win) == 0);
+        win.push(&win, 3, time + max_age);
+        assert(win.min(&win) == 3 && win.max(&win) == 3);
+        win.clear(&win);
+        assert(Deque_int_Window_empty(&win) && win.sum(&win) == 0);
+        win.dtor(&win);
+
+        // Count only window of doubles, sum stays exact for values which are multiples of 0.5
+        Deque_double_Window double_win;
+        Deque_double_Window_ctor(&double_win, 3, 0, double_less);
+        double values[] = {1.5, -2.0, 4.5, 0.5, 0.5, -3.0};
+        double expected_min[] = {1.5, -2.0, -2.0, -2.0, 0.5, -3.0};
+        double expected_max[] = {1.5, 1.5, 4.5, 4.5, 4.5, 0.5};
+        double expected_sum[] = {1.5, -0.5, 4.0, 3.0, 5.5, -2.0};
+        for (int i = 0; i < 6; i++) {
+            double_win.push(&double_win, values[i], 1000000 * i);
+            assert(double_win.min(&double_win) == expected_min[i] && double_win.max(&double_win) == expected_max[i]);
+            assert(double_win.sum(&double_win) == expected_sum[i]);
+        }
+        double_win.dtor(&double_win);
+    }
+
     fclose(devnull);
 
     return 0;
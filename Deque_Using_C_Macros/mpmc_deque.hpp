@@ -0,0 +1,243 @@
+#ifndef NITESH_MPMC_DEQUE_H
+#define NITESH_MPMC_DEQUE_H
+
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "deque.hpp"
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+#define MPMC_SPIN_LIMIT 64
+
+/*
+ * Futex helpers used to park threads of blocking MPMC Deque calls (Linux only)
+ */
+inline void mpmc_futex_wait(std::atomic<uint32_t> *word, uint32_t expected) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+inline void mpmc_futex_wake(std::atomic<uint32_t> *word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+/*
+ * Macro to implement methods related to bounded Multi Producer Multi Consumer Deque using Stringification
+ * Bounded queue of Dmitry Vyukov: each slot has a sequence number telling whether it is ready to be written
+ * (sequence == position) or to be read (sequence == position + 1) for the current lap of the ring.
+ * Producers and consumers claim positions with a CAS on their own counter, so they only contend with
+ * their own side. Blocking calls spin for a while and then park on a futex. A waiter registers itself
+ * before checking the queue again, so the opposite side always sees it and wakes it after progress.
+ */
+#define Deque_MPMC_Custom(t)                                                                                                                    \
+    using namespace std;                                                                                                                        \
+    /* Structure to represent slot of MPMC Deque */                                                                                             \
+    struct Deque_##t##_MPMC_Slot {                                                                                                              \
+        atomic<size_t> sequence;                                                                                                                \
+        t value;                                                                                                                                \
+    };                                                                                                                                          \
+    /* Structure to represent side of MPMC Deque on which threads can park */                                                                   \
+    struct Deque_##t##_MPMC_Parking {                                                                                                           \
+        atomic<uint32_t> epoch;                                                                                                                 \
+        atomic<uint32_t> waiters;                                                                                                               \
+    };                                                                                                                                          \
+    /* Structure to represent MPMC Deque */                                                                                                     \
+    struct Deque_##t##_MPMC {                                                                                                                   \
+        /* Variable declaration for MPMC Deque (read only after construction) */                                                                \
+        char type_name[(sizeof "Deque_") + (sizeof #t) + (sizeof "_MPMC") - 2];                                                                 \
+        Deque_##t##_MPMC_Slot *t##_slots;                                                                                                       \
+        size_t list_capacity;                                                                                                                   \
+        size_t list_capacity_mask;                                                                                                              \
+        /* Function Pointer declaration for MPMC Deque */                                                                                       \
+        size_t (*size)(Deque_##t##_MPMC *deq);                                                                                                  \
+        bool (*empty)(Deque_##t##_MPMC *deq);                                                                                                   \
+        bool (*try_push_back)(Deque_##t##_MPMC *deq, t);                                                                                        \
+        bool (*try_pop_front)(Deque_##t##_MPMC *deq, t *dst);                                                                                   \
+        void (*push_back)(Deque_##t##_MPMC *deq, t);                                                                                            \
+        void (*pop_front)(Deque_##t##_MPMC *deq, t *dst);                                                                                       \
+        void (*dtor)(Deque_##t##_MPMC *deq);                                                                                                    \
+        /* Positions claimed by producers and consumers, each on its own cache line */                                                          \
+        alignas(CACHE_LINE_SIZE) atomic<size_t> enqueue_position;                                                                               \
+        alignas(CACHE_LINE_SIZE) atomic<size_t> dequeue_position;                                                                               \
+        /* Parking words for producers waiting on full and consumers waiting on empty Deque */                                                  \
+        alignas(CACHE_LINE_SIZE) Deque_##t##_MPMC_Parking producers_parking;                                                                    \
+        alignas(CACHE_LINE_SIZE) Deque_##t##_MPMC_Parking consumers_parking;                                                                    \
+    };                                                                                                                                          \
+    /* Typedef for MPMC Deque struct */                                                                                                         \
+    typedef struct Deque_##t##_MPMC Deque_##t##_MPMC;                                                                                           \
+    /* Function returns number of elements present in MPMC Deque (approximate while threads are active) */                                      \
+    inline size_t list_size(Deque_##t##_MPMC *deq) {                                                                                            \
+        size_t dequeue_position = deq->dequeue_position.load(memory_order_acquire);                                                             \
+        size_t enqueue_position = deq->enqueue_position.load(memory_order_acquire);                                                             \
+        return (enqueue_position > dequeue_position) ? enqueue_position - dequeue_position : 0;                                                 \
+    }                                                                                                                                           \
+    /* Function returns true if MPMC Deque is empty otherwise false */                                                                          \
+    inline bool list_empty(Deque_##t##_MPMC *deq) {                                                                                             \
+        return (list_size(deq) == 0);                                                                                                           \
+    }                                                                                                                                           \
+    /* Function to wake one thread parked on the given side after the opposite side made progress */                                            \
+    inline void wake_mpmc(Deque_##t##_MPMC_Parking *parking) {                                                                                  \
+        /* Orders the slot update before reading waiters (pairs with the fence in park_mpmc) */                                                 \
+        atomic_thread_fence(memory_order_seq_cst);                                                                                              \
+        if (parking->waiters.load(memory_order_relaxed) != 0) {                                                                                 \
+            parking->epoch.fetch_add(1, memory_order_release);                                                                                  \
+            mpmc_futex_wake(&parking->epoch, 1);                                                                                                \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to push new element to back side of MPMC Deque, returns false if it is full */                                                  \
+    inline bool try_push_back_mpmc(Deque_##t##_MPMC *deq, t new_##t) {                                                                          \
+        Deque_##t##_MPMC_Slot *slot;                                                                                                            \
+        size_t position = deq->enqueue_position.load(memory_order_relaxed);                                                                     \
+        while (true) {                                                                                                                          \
+            slot = &deq->t##_slots[position & deq->list_capacity_mask];                                                                         \
+            intptr_t difference = (intptr_t) slot->sequence.load(memory_order_acquire) - (intptr_t) position;                                   \
+            if (difference == 0) {                                                                                                              \
+                /* Slot is free in this lap, claim the position */                                                                              \
+                if (deq->enqueue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {                                \
+                    break;                                                                                                                      \
+                }                                                                                                                               \
+            } else if (difference < 0) {                                                                                                        \
+                /* Slot still holds an element of the previous lap, so Deque is full */                                                         \
+                return false;                                                                                                                   \
+            } else {                                                                                                                            \
+                position = deq->enqueue_position.load(memory_order_relaxed);                                                                    \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+        slot->value = std::move(new_##t);                                                                                                       \
+        slot->sequence.store(position + 1, memory_order_release);                                                                               \
+        wake_mpmc(&deq->consumers_parking);                                                                                                     \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to pop element from front side of MPMC Deque into dst, returns false if it is empty */                                          \
+    inline bool try_pop_front_mpmc(Deque_##t##_MPMC *deq, t *dst) {                                                                             \
+        Deque_##t##_MPMC_Slot *slot;                                                                                                            \
+        size_t position = deq->dequeue_position.load(memory_order_relaxed);                                                                     \
+        while (true) {                                                                                                                          \
+            slot = &deq->t##_slots[position & deq->list_capacity_mask];                                                                         \
+            intptr_t difference = (intptr_t) slot->sequence.load(memory_order_acquire) - (intptr_t) (position + 1);                             \
+            if (difference == 0) {                                                                                                              \
+                /* Slot holds an element of this lap, claim the position */                                                                     \
+                if (deq->dequeue_position.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {                                \
+                    break;                                                                                                                      \
+                }                                                                                                                               \
+            } else if (difference < 0) {                                                                                                        \
+                /* Slot is not written yet, so Deque is empty */                                                                                \
+                return false;                                                                                                                   \
+            } else {                                                                                                                            \
+                position = deq->dequeue_position.load(memory_order_relaxed);                                                                    \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+        *dst = slot->value;                                                                                                                     \
+        /* Make the slot free for the producer of the next lap */                                                                               \
+        slot->sequence.store(position + deq->list_capacity, memory_order_release);                                                              \
+        wake_mpmc(&deq->producers_parking);                                                                                                     \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to push new element to back side of MPMC Deque, waits while it is full */                                                       \
+    inline void push_back_mpmc(Deque_##t##_MPMC *deq, t new_##t) {                                                                              \
+        for (int spin = 0; spin < MPMC_SPIN_LIMIT; spin++) {                                                                                    \
+            if (try_push_back_mpmc(deq, new_##t)) {                                                                                             \
+                return;                                                                                                                         \
+            }                                                                                                                                   \
+            /* Give the opposite side a chance to run when threads outnumber cores */                                                           \
+            this_thread::yield();                                                                                                               \
+        }                                                                                                                                       \
+        Deque_##t##_MPMC_Parking *parking = &deq->producers_parking;                                                                            \
+        parking->waiters.fetch_add(1, memory_order_relaxed);                                                                                    \
+        while (true) {                                                                                                                          \
+            atomic_thread_fence(memory_order_seq_cst);                                                                                          \
+            uint32_t epoch = parking->epoch.load(memory_order_acquire);                                                                         \
+            if (try_push_back_mpmc(deq, new_##t)) {                                                                                             \
+                break;                                                                                                                          \
+            }                                                                                                                                   \
+            mpmc_futex_wait(&parking->epoch, epoch);                                                                                            \
+        }                                                                                                                                       \
+        parking->waiters.fetch_sub(1, memory_order_relaxed);                                                                                    \
+    }                                                                                                                                           \
+    /* Function to pop element from front side of MPMC Deque into dst, waits while it is empty */                                               \
+    inline void pop_front_mpmc(Deque_##t##_MPMC *deq, t *dst) {                                                                                 \
+        for (int spin = 0; spin < MPMC_SPIN_LIMIT; spin++) {                                                                                    \
+            if (try_pop_front_mpmc(deq, dst)) {                                                                                                 \
+                return;                                                                                                                         \
+            }                                                                                                                                   \
+            /* Give the opposite side a chance to run when threads outnumber cores */                                                           \
+            this_thread::yield();                                                                                                               \
+        }                                                                                                                                       \
+        Deque_##t##_MPMC_Parking *parking = &deq->consumers_parking;                                                                            \
+        parking->waiters.fetch_add(1, memory_order_relaxed);                                                                                    \
+        while (true) {                                                                                                                          \
+            atomic_thread_fence(memory_order_seq_cst);                                                                                          \
+            uint32_t epoch = parking->epoch.load(memory_order_acquire);                                                                         \
+            if (try_pop_front_mpmc(deq, dst)) {                                                                                                 \
+                break;                                                                                                                          \
+            }                                                                                                                                   \
+            mpmc_futex_wait(&parking->epoch, epoch);                                                                                            \
+        }                                                                                                                                       \
+        parking->waiters.fetch_sub(1, memory_order_relaxed);                                                                                    \
+    }                                                                                                                                           \
+    /* Function to deallocate all the heap memory allocations for MPMC Deque (no thread may use it anymore) */                                  \
+    inline void dtor_mpmc(Deque_##t##_MPMC *deq) {                                                                                              \
+        delete[] deq->t##_slots;                                                                                                                \
+        deq->t##_slots = nullptr;                                                                                                               \
+    }                                                                                                                                           \
+    /* Direct-call API matching the one of Deque_Custom */                                                                                      \
+    inline size_t Deque_##t##_MPMC_size(Deque_##t##_MPMC *deq) {                                                                                \
+        return list_size(deq);                                                                                                                  \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_MPMC_empty(Deque_##t##_MPMC *deq) {                                                                                 \
+        return list_empty(deq);                                                                                                                 \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_MPMC_try_push_back(Deque_##t##_MPMC *deq, t new_##t) {                                                              \
+        return try_push_back_mpmc(deq, std::move(new_##t));                                                                                     \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_MPMC_try_pop_front(Deque_##t##_MPMC *deq, t *dst) {                                                                 \
+        return try_pop_front_mpmc(deq, dst);                                                                                                    \
+    }                                                                                                                                           \
+    inline void Deque_##t##_MPMC_push_back(Deque_##t##_MPMC *deq, t new_##t) {                                                                  \
+        push_back_mpmc(deq, std::move(new_##t));                                                                                                \
+    }                                                                                                                                           \
+    inline void Deque_##t##_MPMC_pop_front(Deque_##t##_MPMC *deq, t *dst) {                                                                     \
+        pop_front_mpmc(deq, dst);                                                                                                               \
+    }                                                                                                                                           \
+    inline void Deque_##t##_MPMC_dtor(Deque_##t##_MPMC *deq) {                                                                                  \
+        dtor_mpmc(deq);                                                                                                                         \
+    }                                                                                                                                           \
+    /* Function to construct the MPMC Deque with capacity rounded up to a power of two (must not be shared yet) */                              \
+    inline void Deque_##t##_MPMC_ctor(Deque_##t##_MPMC *deq, size_t capacity) {                                                                 \
+        size_t list_capacity = LIST_CAPACITY;                                                                                                   \
+        while (list_capacity < capacity) {                                                                                                      \
+            list_capacity *= DOUBLE;                                                                                                            \
+        }                                                                                                                                       \
+        /* Memory allocation for slots with fixed size */                                                                                       \
+        deq->t##_slots = new Deque_##t##_MPMC_Slot[list_capacity];                                                                              \
+        /* Logic if Heap memory allocated correctly */                                                                                          \
+        if (deq->t##_slots != nullptr) {                                                                                                        \
+            strcpy(deq->type_name, ("Deque_" #t "_MPMC"));                                                                                      \
+            deq->list_capacity = list_capacity;                                                                                                 \
+            deq->list_capacity_mask = list_capacity - 1;                                                                                        \
+            for (size_t i = 0; i < list_capacity; i++) {                                                                                        \
+                deq->t##_slots[i].sequence.store(i, memory_order_relaxed);                                                                      \
+            }                                                                                                                                   \
+            deq->enqueue_position.store(0, memory_order_relaxed);                                                                               \
+            deq->dequeue_position.store(0, memory_order_relaxed);                                                                               \
+            deq->producers_parking.epoch.store(0, memory_order_relaxed);                                                                        \
+            deq->producers_parking.waiters.store(0, memory_order_relaxed);                                                                      \
+            deq->consumers_parking.epoch.store(0, memory_order_relaxed);                                                                        \
+            deq->consumers_parking.waiters.store(0, memory_order_relaxed);                                                                      \
+            /* Initialization of function pointers */                                                                                           \
+            deq->size = list_size;                                                                                                              \
+            deq->empty = list_empty;                                                                                                            \
+            deq->try_push_back = &try_push_back_mpmc;                                                                                           \
+            deq->try_pop_front = &try_pop_front_mpmc;                                                                                           \
+            deq->push_back = &push_back_mpmc;                                                                                                   \
+            deq->pop_front = &pop_front_mpmc;                                                                                                   \
+            deq->dtor = &dtor_mpmc;                                                                                                             \
+        }                                                                                                                                       \
+    }
+
+#endif
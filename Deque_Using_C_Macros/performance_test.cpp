@@ -9,14 +9,42 @@
 #include <cstdint>
 #include <random>
 #include <unistd.h>
+#include <fcntl.h>
 #include "deque.hpp"
+#include "segmented_deque.hpp"
+#include "spsc_deque.hpp"
+#include "mpmc_deque.hpp"
+#include "window_deque.hpp"
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <atomic>
 #include <chrono>
+#include <string>
 
 bool int_less(const int &o1, const int &o2) {
     return o1 < o2;
 }
 
 Deque_Custom(int)
+Deque_Segmented_Custom(int)
+Deque_SPSC_Custom(int)
+Deque_MPMC_Custom(int)
+Deque_Window_Custom(int)
+
+bool string_less(const string &o1, const string &o2) {
+    return o1 < o2;
+}
+
+Deque_Custom(string)
+
+typedef unsigned int uint;
+
+bool uint_less(const uint &o1, const uint &o2) {
+    return o1 < o2;
+}
+
+Deque_Custom_Small(uint, 8)
 
 int main() {
 
@@ -54,6 +82,495 @@ int main() {
     Milli elapsed = end - start;
     assert(elapsed.count() < 2000);
 
+    // Compare calls through function pointers with the direct-call API
+    {
+        size_t sum_pointer = 0, sum_direct = 0;
+        int lo = 0, hi = 10000000;
+        Deque_int deq, direct_deq;
+        Deque_int_ctor(&deq, int_less);
+        Deque_int_ctor(&direct_deq, int_less);
+
+        start = system_clock::now();
+        for (int i = lo; i < hi; i++) {
+            deq.push_back(&deq, i);
+        }
+        for (int i = lo; i < hi; i++) {
+            sum_pointer += deq.at(&deq, i);
+        }
+        for (int i = lo; i < hi; i++) {
+            deq.pop_front(&deq);
+        }
+        end = system_clock::now();
+        Milli pointer_elapsed = end - start;
+
+        start = system_clock::now();
+        for (int i = lo; i < hi; i++) {
+            Deque_int_push_back(&direct_deq, i);
+        }
+        for (int i = lo; i < hi; i++) {
+            sum_direct += Deque_int_at(&direct_deq, i);
+        }
+        for (int i = lo; i < hi; i++) {
+            Deque_int_pop_front(&direct_deq);
+        }
+        end = system_clock::now();
+        Milli direct_elapsed = end - start;
+
+        deq.dtor(&deq);
+        Deque_int_dtor(&direct_deq);
+
+        assert(sum_pointer == 49999995000000 && sum_direct == sum_pointer);
+        printf("function pointer calls: %.1f ms, direct calls: %.1f ms\n", pointer_elapsed.count(), direct_elapsed.count());
+        assert(direct_elapsed.count() < 2000);
+    }
+
+    // Compare element by element transfer with bursts of 256 elements
+    {
+        const int burst_size = 256, bursts = 40000;
+        int burst[burst_size], drained[burst_size];
+        size_t sum_single = 0, sum_bulk = 0;
+        Deque_int deq, bulk_deq;
+        Deque_int_ctor(&deq, int_less);
+        Deque_int_ctor(&bulk_deq, int_less);
+        for (int i = 0; i < burst_size; i++) {
+            burst[i] = i;
+        }
+
+        start = system_clock::now();
+        for (int b = 0; b < bursts; b++) {
+            for (int i = 0; i < burst_size; i++) {
+                Deque_int_push_back(&deq, burst[i]);
+            }
+            for (int i = 0; i < burst_size; i++) {
+                sum_single += Deque_int_front(&deq);
+                Deque_int_pop_front(&deq);
+            }
+        }
+        end = system_clock::now();
+        Milli single_elapsed = end - start;
+
+        start = system_clock::now();
+        for (int b = 0; b < bursts; b++) {
+            Deque_int_push_back_n(&bulk_deq, burst, burst_size);
+            size_t copied = Deque_int_copy_out(&bulk_deq, drained, burst_size);
+            Deque_int_pop_front_n(&bulk_deq, copied);
+            for (size_t i = 0; i < copied; i++) {
+                sum_bulk += drained[i];
+            }
+        }
+        end = system_clock::now();
+        Milli bulk_elapsed = end - start;
+
+        deq.dtor(&deq);
+        bulk_deq.dtor(&bulk_deq);
+
+        assert(sum_single == sum_bulk);
+        printf("single element transfer: %.1f ms, bulk transfer: %.1f ms\n", single_elapsed.count(), bulk_elapsed.count());
+        assert(bulk_elapsed.count() < 2000);
+    }
+
+    // Two thread hand off through a mutex protected deque and through the SPSC deque
+    {
+        const int total = 10000000, batch = 64;
+        size_t sum_mutex = 0, sum_spsc = 0, sum_batch = 0;
+
+        Deque_int locked_deq;
+        Deque_int_ctor(&locked_deq, int_less);
+        std::mutex deq_mutex;
+        start = system_clock::now();
+        std::thread mutex_producer([&]() {
+            for (int i = 0; i < total; i++) {
+                std::lock_guard<std::mutex> lock(deq_mutex);
+                Deque_int_push_back(&locked_deq, i);
+            }
+        });
+        for (int received = 0; received < total;) {
+            std::lock_guard<std::mutex> lock(deq_mutex);
+            if (!Deque_int_empty(&locked_deq)) {
+                sum_mutex += Deque_int_front(&locked_deq);
+                Deque_int_pop_front(&locked_deq);
+                received++;
+            }
+        }
+        mutex_producer.join();
+        end = system_clock::now();
+        Milli mutex_elapsed = end - start;
+        locked_deq.dtor(&locked_deq);
+
+        Deque_int_SPSC spsc_deq;
+        Deque_int_SPSC_ctor(&spsc_deq, 4096);
+        start = system_clock::now();
+        std::thread spsc_producer([&]() {
+            for (int i = 0; i < total;) {
+                if (Deque_int_SPSC_try_push_back(&spsc_deq, i)) {
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        for (int received = 0, value = 0; received < total;) {
+            if (Deque_int_SPSC_try_pop_front(&spsc_deq, &value)) {
+                sum_spsc += value;
+                received++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        spsc_producer.join();
+        end = system_clock::now();
+        Milli spsc_elapsed = end - start;
+
+        start = system_clock::now();
+        std::thread batch_producer([&]() {
+            int burst[batch];
+            for (int i = 0; i < total;) {
+                int count = std::min(batch, total - i);
+                for (int j = 0; j < count; j++) {
+                    burst[j] = i + j;
+                }
+                size_t pushed = Deque_int_SPSC_try_push_back_n(&spsc_deq, burst, count);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                i += (int) pushed;
+            }
+        });
+        int received_batch[batch];
+        for (int received = 0; received < total;) {
+            size_t count = Deque_int_SPSC_try_pop_front_n(&spsc_deq, received_batch, batch);
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            for (size_t j = 0; j < count; j++) {
+                sum_batch += received_batch[j];
+            }
+            received += (int) count;
+        }
+        batch_producer.join();
+        end = system_clock::now();
+        Milli batch_elapsed = end - start;
+        spsc_deq.dtor(&spsc_deq);
+
+        assert(sum_mutex == 49999995000000 && sum_spsc == sum_mutex && sum_batch == sum_mutex);
+        printf("two thread hand off of %d ints: mutex %.1f ms, spsc %.1f ms, spsc batch %.1f ms\n", total,
+               mutex_elapsed.count(), spsc_elapsed.count(), batch_elapsed.count());
+    }
+
+    // Scaling of mutex protected deque and MPMC deque with 1 to N producer/consumer pairs
+    {
+        const int total = 2000000;
+        unsigned max_pairs = std::max(4u, std::thread::hardware_concurrency());
+        for (unsigned pairs = 1; pairs <= max_pairs; pairs *= 2) {
+            int per_thread = total / (int) pairs;
+            std::atomic<long long> sum_mutex(0), sum_mpmc(0);
+            std::vector<std::thread> workers;
+
+            Deque_int locked_deq;
+            Deque_int_ctor(&locked_deq, int_less);
+            std::mutex deq_mutex;
+            start = system_clock::now();
+            for (unsigned p = 0; p < pairs; p++) {
+                workers.emplace_back([&]() {
+                    for (int i = 0; i < per_thread; i++) {
+                        std::lock_guard<std::mutex> lock(deq_mutex);
+                        Deque_int_push_back(&locked_deq, i);
+                    }
+                });
+                workers.emplace_back([&]() {
+                    long long sum = 0;
+                    for (int received = 0; received < per_thread;) {
+                        std::unique_lock<std::mutex> lock(deq_mutex);
+                        if (Deque_int_empty(&locked_deq)) {
+                            lock.unlock();
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        sum += Deque_int_front(&locked_deq);
+                        Deque_int_pop_front(&locked_deq);
+                        received++;
+                    }
+                    sum_mutex += sum;
+                });
+            }
+            for (auto &worker : workers) {
+                worker.join();
+            }
+            end = system_clock::now();
+            Milli mutex_elapsed = end - start;
+            locked_deq.dtor(&locked_deq);
+            workers.clear();
+
+            Deque_int_MPMC mpmc_deq;
+            Deque_int_MPMC_ctor(&mpmc_deq, 4096);
+            start = system_clock::now();
+            for (unsigned p = 0; p < pairs; p++) {
+                workers.emplace_back([&]() {
+                    for (int i = 0; i < per_thread; i++) {
+                        Deque_int_MPMC_push_back(&mpmc_deq, i);
+                    }
+                });
+                workers.emplace_back([&]() {
+                    long long sum = 0;
+                    int value;
+                    for (int received = 0; received < per_thread; received++) {
+                        Deque_int_MPMC_pop_front(&mpmc_deq, &value);
+                        sum += value;
+                    }
+                    sum_mpmc += sum;
+                });
+            }
+            for (auto &worker : workers) {
+                worker.join();
+            }
+            end = system_clock::now();
+            Milli mpmc_elapsed = end - start;
+            mpmc_deq.dtor(&mpmc_deq);
+
+            assert(sum_mutex == sum_mpmc);
+            printf("%u producer/consumer pairs, %d ints: mutex %.1f ms, mpmc %.1f ms\n", pairs, per_thread * (int) pairs,
+                   mutex_elapsed.count(), mpmc_elapsed.count());
+        }
+    }
+
+    // Sort of 10M element deque which wraps around the ring buffer, compare sort with radix sort
+    {
+        std::mt19937 engine(42);
+        Deque_int deq, radix_deq;
+        Deque_int_ctor(&deq, int_less);
+        Deque_int_ctor(&radix_deq, int_less);
+        for (int i = 0; i < 10000000; i++) {
+            int value = (int) (engine() >> 1);
+            if (i % 2 == 0) {
+                Deque_int_push_back(&deq, value);
+                Deque_int_push_back(&radix_deq, value);
+            } else {
+                Deque_int_push_front(&deq, value);
+                Deque_int_push_front(&radix_deq, value);
+            }
+        }
+
+        start = system_clock::now();
+        deq.sort(&deq, deq.begin(&deq), deq.end(&deq));
+        end = system_clock::now();
+        Milli sort_elapsed = end - start;
+
+        start = system_clock::now();
+        radix_deq.radix_sort(&radix_deq, radix_deq.begin(&radix_deq), radix_deq.end(&radix_deq));
+        end = system_clock::now();
+        Milli radix_elapsed = end - start;
+        assert(Deque_int_equal(deq, radix_deq));
+
+        // Shuffle again and sort using all cores
+        std::shuffle(Deque_int_ring_begin(&radix_deq), Deque_int_ring_end(&radix_deq), engine);
+        start = system_clock::now();
+        radix_deq.parallel_sort(&radix_deq, radix_deq.begin(&radix_deq), radix_deq.end(&radix_deq), 0);
+        end = system_clock::now();
+        Milli parallel_elapsed = end - start;
+        assert(Deque_int_equal(deq, radix_deq));
+
+        printf("sort of 10M ints: sort %.1f ms, radix sort %.1f ms, parallel sort (%u threads) %.1f ms\n", sort_elapsed.count(),
+               radix_elapsed.count(), std::max(1u, std::thread::hardware_concurrency()), parallel_elapsed.count());
+        deq.dtor(&deq);
+        radix_deq.dtor(&radix_deq);
+    }
+
+    // Flush a wrapped deque to /dev/null through a staging buffer and with writev straight from the ring
+    {
+        const int flush_elements = 1000000, flushes = 100;
+        Deque_int deq;
+        Deque_int_ctor(&deq, int_less);
+        for (int i = 0; i < flush_elements; i++) {
+            if (i % 2 == 0) {
+                Deque_int_push_back(&deq, i);
+            } else {
+                Deque_int_push_front(&deq, i);
+            }
+        }
+        int null_fd = open("/dev/null", O_WRONLY);
+        assert(null_fd >= 0);
+        std::vector<int> staging(flush_elements);
+
+        start = system_clock::now();
+        for (int i = 0; i < flushes; i++) {
+            size_t copied = Deque_int_copy_out(&deq, staging.data(), flush_elements);
+            ssize_t bytes = write(null_fd, staging.data(), copied * sizeof(int));
+            assert(bytes == (ssize_t) (copied * sizeof(int)));
+        }
+        end = system_clock::now();
+        Milli staging_elapsed = end - start;
+
+        start = system_clock::now();
+        for (int i = 0; i < flushes; i++) {
+            ssize_t bytes = Deque_int_write_to_fd(&deq, null_fd);
+            assert(bytes == (ssize_t) (flush_elements * sizeof(int)));
+        }
+        end = system_clock::now();
+        Milli writev_elapsed = end - start;
+
+        close(null_fd);
+        Deque_int_dtor(&deq);
+        printf("flush of 1M ints x %d: staging copy + write %.1f ms, writev %.1f ms\n", flushes, staging_elapsed.count(),
+               writev_elapsed.count());
+    }
+
+    // Queue of 10M ints through segmented deque with 4 MB memory budget, most of it is spilled to disk
+    {
+        Deque_int_Segmented deq;
+        Deque_int_Segmented_ctor(&deq, int_less);
+        int spill_result = Deque_int_Segmented_spill_to(&deq, "/tmp/deque_spill_perf", 4 << 20);
+        assert(spill_result == 0);
+        start = system_clock::now();
+        for (int i = 0; i < 10000000; i++) {
+            Deque_int_Segmented_push_back(&deq, i);
+        }
+        size_t spilled_blocks = deq.block_count - deq.front_resident_blocks - deq.back_resident_blocks;
+        for (int i = 0; i < 10000000; i++) {
+            assert(Deque_int_Segmented_front(&deq) == i);
+            Deque_int_Segmented_pop_front(&deq);
+        }
+        end = system_clock::now();
+        Milli spill_elapsed = end - start;
+        Deque_int_Segmented_dtor(&deq);
+        printf("segmented deque spill of %zu blocks, 10M push and pop: %.1f ms\n", spilled_blocks, spill_elapsed.count());
+    }
+
+    // Fill deque with 1M heap allocated strings by copying push and by emplace (growth moves the strings)
+    {
+        const int string_count = 1000000;
+        const std::string value(40, 'x');
+        Deque_string copy_deq, emplace_deq;
+        Deque_string_ctor(&copy_deq, string_less);
+        Deque_string_ctor(&emplace_deq, string_less);
+
+        start = system_clock::now();
+        for (int i = 0; i < string_count; i++) {
+            Deque_string_push_back(&copy_deq, value);
+        }
+        end = system_clock::now();
+        Milli copy_elapsed = end - start;
+
+        start = system_clock::now();
+        for (int i = 0; i < string_count; i++) {
+            Deque_string_emplace_back(&emplace_deq, (size_t) 40, 'x');
+        }
+        end = system_clock::now();
+        Milli emplace_elapsed = end - start;
+
+        assert(Deque_string_equal(copy_deq, emplace_deq));
+        Deque_string_dtor(&copy_deq);
+        Deque_string_dtor(&emplace_deq);
+        printf("push of 1M strings: copying push_back %.1f ms, emplace_back %.1f ms\n", copy_elapsed.count(), emplace_elapsed.count());
+    }
+
+    // Short lived deques holding a few elements, regular deque allocates its buffer while small deque does not
+    {
+        const int temporaries = 1000000;
+        size_t sum = 0, small_sum = 0;
+
+        start = system_clock::now();
+        for (int i = 0; i < temporaries; i++) {
+            Deque_int deq;
+            Deque_int_ctor(&deq, int_less);
+            Deque_int_push_back(&deq, i);
+            Deque_int_push_front(&deq, 1);
+            Deque_int_push_back(&deq, 2);
+            sum += Deque_int_front(&deq) + Deque_int_back(&deq) + Deque_int_at(&deq, 1);
+            Deque_int_dtor(&deq);
+        }
+        end = system_clock::now();
+        Milli regular_elapsed = end - start;
+
+        start = system_clock::now();
+        for (int i = 0; i < temporaries; i++) {
+            Deque_uint deq;
+            Deque_uint_ctor(&deq, uint_less);
+            Deque_uint_push_back(&deq, i);
+            Deque_uint_push_front(&deq, 1);
+            Deque_uint_push_back(&deq, 2);
+            small_sum += Deque_uint_front(&deq) + Deque_uint_back(&deq) + Deque_uint_at(&deq, 1);
+            Deque_uint_dtor(&deq);
+        }
+        end = system_clock::now();
+        Milli small_elapsed = end - start;
+
+        assert(sum == small_sum);
+        printf("1M short lived deques: regular %.1f ms, small (inline storage) %.1f ms\n", regular_elapsed.count(),
+               small_elapsed.count());
+    }
+
+    // Rolling window of 1M samples at 100 kHz (10 us apart, 10 s max age), 10M ticks reading min, max and sum every tick
+    {
+        const int ticks = 10000000, window_samples = 1000000, scanned_ticks = 100;
+        std::mt19937 engine(3);
+        long long checksum = 0;
+        Deque_int_Window win;
+        Deque_int_Window_ctor(&win, window_samples, 10000000, int_less);
+
+        start = system_clock::now();
+        for (int i = 0; i < ticks; i++) {
+            Deque_int_Window_push(&win, (int) (engine() % 1000000), 10LL * i);
+            checksum += Deque_int_Window_min(&win) + Deque_int_Window_max(&win) + Deque_int_Window_sum(&win);
+        }
+        end = system_clock::now();
+        Milli window_elapsed = end - start;
+        assert(Deque_int_Window_size(&win) == (size_t) window_samples);
+
+        // Recomputing min, max and sum by scanning the full window with at
+        Deque_int deq;
+        Deque_int_ctor(&deq, int_less);
+        for (int i = 0; i < window_samples; i++) {
+            Deque_int_push_back(&deq, (int) (engine() % 1000000));
+        }
+        start = system_clock::now();
+        for (int i = 0; i < scanned_ticks; i++) {
+            Deque_int_pop_front(&deq);
+            Deque_int_push_back(&deq, (int) (engine() % 1000000));
+            int min_value = Deque_int_at(&deq, 0), max_value = min_value;
+            long long sum = 0;
+            for (int j = 0; j < window_samples; j++) {
+                int value = Deque_int_at(&deq, j);
+                min_value = std::min(min_value, value);
+                max_value = std::max(max_value, value);
+                sum += value;
+            }
+            checksum += min_value + max_value + sum;
+        }
+        end = system_clock::now();
+        Milli scan_elapsed = end - start;
+
+        Deque_int_dtor(&deq);
+        Deque_int_Window_dtor(&win);
+        printf("window of 1M samples: %.1f ns per tick with monotonic window, %.1f ns per tick scanning (checksum %lld)\n",
+               window_elapsed.count() * 1e6 / ticks, scan_elapsed.count() * 1e6 / scanned_ticks, checksum);
+    }
+
+    start = system_clock::now();
+
+    // Test random access performance of segmented deque
+    {
+        size_t sum = 0;
+        int lo = 0, hi = 10000000;
+        Deque_int_Segmented deq;
+        Deque_int_Segmented_ctor(&deq, int_less);
+
+        for (int i = lo; i < hi; i++) {
+            deq.push_back(&deq, i);
+        }
+
+        for (int i = lo; i < hi; i++) {
+            sum += deq.at(&deq, i);
+        }
+
+        deq.dtor(&deq);
+
+        assert(sum == 49999995000000);
+    }
+
+    end = system_clock::now();
+    elapsed = end - start;
+    assert(elapsed.count() < 2000);
+
     int rv = fclose(devnull);
     assert(rv == 0);
 }
@@ -0,0 +1,636 @@
+#ifndef NITESH_SEGMENTED_DEQUE_H
+#define NITESH_SEGMENTED_DEQUE_H
+
+#include <cstring>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include "deque.hpp"
+
+#define SEGMENT_SHIFT 6
+#define SEGMENT_ELEMENTS (1 << SEGMENT_SHIFT) /* Elements per block (power of two) */
+#define SEGMENT_MASK (SEGMENT_ELEMENTS - 1)
+#define BLOCK_MAP_CAPACITY 8 /* Must be a power of two */
+#define SPILL_MIN_BLOCKS 4 /* Smallest memory budget of spill mode in blocks */
+#define SPILL_READAHEAD_BLOCKS 8 /* Spilled blocks announced to the kernel after paging blocks back in */
+#define SPILL_NO_SLOT SIZE_MAX
+
+// Write size bytes of buf at offset of fd retrying on partial writes, returns false on error
+inline bool deque_pwrite_all(int fd, const void *buf, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t bytes = pwrite(fd, buf, size, offset);
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf = (const char *) buf + bytes;
+        size -= (size_t) bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+// Read size bytes at offset of fd into buf retrying on partial reads, returns false on error or end of file
+inline bool deque_pread_all(int fd, void *buf, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t bytes = pread(fd, buf, size, offset);
+        if (bytes <= 0) {
+            if (bytes < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf = (char *) buf + bytes;
+        size -= (size_t) bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+/*
+ * Macro to implement methods related to Segmented Deque data structure using Stringification
+ * Elements are stored in fixed size blocks and a ring of block pointers (block map) keeps the blocks in order.
+ * Growth only allocates a new block (and sometimes a bigger block map), elements are never moved,
+ * so references to elements stay valid until the element is popped.
+ * In spill mode (see spill_to) only the blocks at both ends are kept in memory, within a memory budget.
+ * Middle blocks are written to a spill file and paged back in, several at a time, when an end reaches them.
+ * Elements of spilled blocks are accessed through a single cache block, so their references stay valid only
+ * until another spilled block is accessed.
+ */
+#define Deque_Segmented_Custom(t)                                                                                                               \
+    using namespace std;                                                                                                                        \
+    /* Forward declaration of structure */                                                                                                      \
+    struct Deque_##t##_Segmented;                                                                                                               \
+    /* Structure to represent Iterator for Segmented Deque */                                                                                   \
+    struct Deque_##t##_Segmented_Iterator {                                                                                                     \
+        /* Variable declaration for Segmented Deque Iterator */                                                                                 \
+        struct Deque_##t##_Segmented *deque_##t;                                                                                                \
+        size_t deque_##t##_index;                                                                                                               \
+        /* Function Pointer declaration for Segmented Deque Iterator */                                                                         \
+        void (*inc)(Deque_##t##_Segmented_Iterator *it);                                                                                        \
+        void (*dec)(Deque_##t##_Segmented_Iterator *it);                                                                                        \
+        t &(*deref)(Deque_##t##_Segmented_Iterator *it);                                                                                        \
+    };                                                                                                                                          \
+    /* Structure to represent Segmented Deque */                                                                                                \
+    struct Deque_##t##_Segmented {                                                                                                              \
+        /* Variable declaration for Segmented Deque */                                                                                          \
+        char type_name[(sizeof "Deque_") + (sizeof #t) + (sizeof "_Segmented") - 2];                                                            \
+        t **block_map;                                                                                                                          \
+        t *spare_block;                                                                                                                         \
+        size_t map_capacity;                                                                                                                    \
+        size_t map_capacity_mask;                                                                                                               \
+        size_t map_front_index;                                                                                                                 \
+        size_t block_count;                                                                                                                     \
+        size_t block_front_offset;                                                                                                              \
+        size_t list_elements;                                                                                                                   \
+        /* Variable declaration for spill mode (spill_fd is -1 when it is off) */                                                               \
+        int spill_fd;                                                                                                                           \
+        size_t spill_budget_blocks;                                                                                                             \
+        size_t front_resident_blocks;                                                                                                           \
+        size_t back_resident_blocks;                                                                                                            \
+        size_t *spill_slot_map;                                                                                                                 \
+        size_t *free_spill_slots;                                                                                                               \
+        size_t free_spill_slot_count;                                                                                                           \
+        size_t free_spill_slot_capacity;                                                                                                        \
+        size_t spill_slot_end;                                                                                                                  \
+        t *spill_cache_block;                                                                                                                   \
+        size_t spill_cache_slot;                                                                                                                \
+        /* Function Pointer declaration for Segmented Deque */                                                                                  \
+        size_t (*size)(Deque_##t##_Segmented *deq);                                                                                             \
+        bool (*empty)(Deque_##t##_Segmented *deq);                                                                                              \
+        void (*push_front)(Deque_##t##_Segmented *deq, t);                                                                                      \
+        void (*push_back)(Deque_##t##_Segmented *deq, t);                                                                                       \
+        void (*pop_front)(Deque_##t##_Segmented *deq);                                                                                          \
+        void (*pop_back)(Deque_##t##_Segmented *deq);                                                                                           \
+        t &(*front)(Deque_##t##_Segmented *deq);                                                                                                \
+        t &(*back)(Deque_##t##_Segmented *deq);                                                                                                 \
+        t &(*at)(Deque_##t##_Segmented *deq, size_t i);                                                                                         \
+        Deque_##t##_Segmented_Iterator (*begin)(Deque_##t##_Segmented *deq);                                                                    \
+        Deque_##t##_Segmented_Iterator (*end)(Deque_##t##_Segmented *deq);                                                                      \
+        void (*clear)(Deque_##t##_Segmented *deq);                                                                                              \
+        void (*dtor)(Deque_##t##_Segmented *deq);                                                                                               \
+        bool (*compare_elements)(const t &o1, const t &o2);                                                                                     \
+        void (*sort)(Deque_##t##_Segmented *deq, Deque_##t##_Segmented_Iterator begin, Deque_##t##_Segmented_Iterator end);                     \
+        int (*spill_to)(Deque_##t##_Segmented *deq, const char *path, size_t memory_budget);                                                    \
+    };                                                                                                                                          \
+    /* Typedef for Segmented Deque and Segmented Deque Iterator structs */                                                                      \
+    typedef struct Deque_##t##_Segmented_Iterator Deque_##t##_Segmented_Iterator;                                                               \
+    typedef struct Deque_##t##_Segmented Deque_##t##_Segmented;                                                                                 \
+    /* Function returns number of elements present in Segmented Deque */                                                                        \
+    inline size_t list_size(Deque_##t##_Segmented *deq) {                                                                                       \
+        return deq->list_elements;                                                                                                              \
+    }                                                                                                                                           \
+    /* Function returns true if Segmented Deque is empty otherwise false */                                                                     \
+    inline bool list_empty(Deque_##t##_Segmented *deq) {                                                                                        \
+        return (deq->list_elements == 0);                                                                                                       \
+    }                                                                                                                                           \
+    /* Function returns number of blocks stored in the spill file */                                                                            \
+    inline size_t spilled_blocks_segmented(Deque_##t##_Segmented *deq) {                                                                        \
+        return (deq->spill_fd < 0) ? 0 : deq->block_count - deq->front_resident_blocks - deq->back_resident_blocks;                             \
+    }                                                                                                                                           \
+    /* Function returns offset of the given slot in the spill file */                                                                           \
+    inline off_t spill_offset_segmented(Deque_##t##_Segmented *, size_t slot) {                                                                 \
+        return (off_t) (slot * SEGMENT_ELEMENTS * sizeof(t));                                                                                   \
+    }                                                                                                                                           \
+    /* Function to write the cache block back to its slot (spilled data can not be lost, so failure aborts) */                                  \
+    inline void flush_spill_cache_segmented(Deque_##t##_Segmented *deq) {                                                                       \
+        if (deq->spill_cache_slot != SPILL_NO_SLOT) {                                                                                           \
+            if (!deque_pwrite_all(deq->spill_fd, (const void *) deq->spill_cache_block, SEGMENT_ELEMENTS * sizeof(t),                           \
+                                  spill_offset_segmented(deq, deq->spill_cache_slot))) {                                                        \
+                perror("Segmented Deque spill write");                                                                                          \
+                abort();                                                                                                                        \
+            }                                                                                                                                   \
+            deq->spill_cache_slot = SPILL_NO_SLOT;                                                                                              \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function returns the cache block holding the spilled block of the given slot */                                                          \
+    inline t *spill_cache_segmented(Deque_##t##_Segmented *deq, size_t slot) {                                                                  \
+        if (deq->spill_cache_slot != slot) {                                                                                                    \
+            flush_spill_cache_segmented(deq);                                                                                                   \
+            if (!deque_pread_all(deq->spill_fd, (void *) deq->spill_cache_block, SEGMENT_ELEMENTS * sizeof(t),                                  \
+                                 spill_offset_segmented(deq, slot))) {                                                                          \
+                perror("Segmented Deque spill read");                                                                                           \
+                abort();                                                                                                                        \
+            }                                                                                                                                   \
+            deq->spill_cache_slot = slot;                                                                                                       \
+        }                                                                                                                                       \
+        return deq->spill_cache_block;                                                                                                          \
+    }                                                                                                                                           \
+    /* Function returns address of the element at the required index (no bounds check) */                                                       \
+    inline t *element_segmented(Deque_##t##_Segmented *deq, size_t req_index) {                                                                 \
+        size_t position = deq->block_front_offset + req_index;                                                                                  \
+        size_t map_index = (deq->map_front_index + (position >> SEGMENT_SHIFT)) & deq->map_capacity_mask;                                       \
+        t *block = deq->block_map[map_index];                                                                                                   \
+        if (block == nullptr) {                                                                                                                 \
+            block = spill_cache_segmented(deq, deq->spill_slot_map[map_index]);                                                                 \
+        }                                                                                                                                       \
+        return &block[position & SEGMENT_MASK];                                                                                                 \
+    }                                                                                                                                           \
+    /* Function returns an empty block (reusing the spare block if there is one) */                                                             \
+    inline t *acquire_block_segmented(Deque_##t##_Segmented *deq) {                                                                             \
+        t *block = deq->spare_block;                                                                                                            \
+        if (block != nullptr) {                                                                                                                 \
+            deq->spare_block = nullptr;                                                                                                         \
+            return block;                                                                                                                       \
+        }                                                                                                                                       \
+        return new t[SEGMENT_ELEMENTS];                                                                                                         \
+    }                                                                                                                                           \
+    /* Function to release a block which no longer holds elements (one block is kept to avoid thrashing) */                                     \
+    inline void release_block_segmented(Deque_##t##_Segmented *deq, t *block) {                                                                 \
+        if (deq->spare_block == nullptr) {                                                                                                      \
+            deq->spare_block = block;                                                                                                           \
+        } else {                                                                                                                                \
+            delete[] block;                                                                                                                     \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to double the capacity of block map when it is full (only block pointers are copied) */                                         \
+    inline void dynamic_map_capacity(Deque_##t##_Segmented *deq) {                                                                              \
+        size_t new_capacity = deq->map_capacity * DOUBLE;                                                                                       \
+        auto **new_map = new t *[new_capacity];                                                                                                 \
+        for (size_t i = 0; i < deq->block_count; i++) {                                                                                         \
+            new_map[i] = deq->block_map[(deq->map_front_index + i) & deq->map_capacity_mask];                                                   \
+        }                                                                                                                                       \
+        delete[] deq->block_map;                                                                                                                \
+        deq->block_map = new_map;                                                                                                               \
+        /* Spill slots follow the same layout as the block pointers */                                                                          \
+        if (deq->spill_slot_map != nullptr) {                                                                                                   \
+            auto *new_slot_map = new size_t[new_capacity];                                                                                      \
+            for (size_t i = 0; i < deq->block_count; i++) {                                                                                     \
+                new_slot_map[i] = deq->spill_slot_map[(deq->map_front_index + i) & deq->map_capacity_mask];                                     \
+            }                                                                                                                                   \
+            delete[] deq->spill_slot_map;                                                                                                       \
+            deq->spill_slot_map = new_slot_map;                                                                                                 \
+        }                                                                                                                                       \
+        deq->map_front_index = 0;                                                                                                               \
+        deq->map_capacity = new_capacity;                                                                                                       \
+        deq->map_capacity_mask = new_capacity - 1;                                                                                              \
+    }                                                                                                                                           \
+    /* Function to write the block at the given position to the spill file, returns false if it has to stay in memory */                        \
+    inline bool spill_block_segmented(Deque_##t##_Segmented *deq, size_t position) {                                                            \
+        size_t map_index = (deq->map_front_index + position) & deq->map_capacity_mask;                                                          \
+        size_t slot = (deq->free_spill_slot_count > 0) ? deq->free_spill_slots[deq->free_spill_slot_count - 1] : deq->spill_slot_end;           \
+        if (!deque_pwrite_all(deq->spill_fd, (const void *) deq->block_map[map_index], SEGMENT_ELEMENTS * sizeof(t),                            \
+                              spill_offset_segmented(deq, slot))) {                                                                             \
+            return false;                                                                                                                       \
+        }                                                                                                                                       \
+        if (slot == deq->spill_slot_end) {                                                                                                      \
+            deq->spill_slot_end++;                                                                                                              \
+        } else {                                                                                                                                \
+            deq->free_spill_slot_count--;                                                                                                       \
+        }                                                                                                                                       \
+        release_block_segmented(deq, deq->block_map[map_index]);                                                                                \
+        deq->block_map[map_index] = nullptr;                                                                                                    \
+        deq->spill_slot_map[map_index] = slot;                                                                                                  \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to read the spilled block at the given position back into memory and free its slot */                                           \
+    inline void load_block_segmented(Deque_##t##_Segmented *deq, size_t position) {                                                             \
+        size_t map_index = (deq->map_front_index + position) & deq->map_capacity_mask;                                                          \
+        size_t slot = deq->spill_slot_map[map_index];                                                                                           \
+        if (deq->spill_cache_slot == slot) {                                                                                                    \
+            flush_spill_cache_segmented(deq);                                                                                                   \
+        }                                                                                                                                       \
+        t *block = acquire_block_segmented(deq);                                                                                                \
+        if (!deque_pread_all(deq->spill_fd, (void *) block, SEGMENT_ELEMENTS * sizeof(t), spill_offset_segmented(deq, slot))) {                 \
+            perror("Segmented Deque spill read");                                                                                               \
+            abort();                                                                                                                            \
+        }                                                                                                                                       \
+        deq->block_map[map_index] = block;                                                                                                      \
+        if (deq->free_spill_slot_count == deq->free_spill_slot_capacity) {                                                                      \
+            size_t new_capacity = std::max((size_t) SPILL_MIN_BLOCKS, deq->free_spill_slot_capacity * DOUBLE);                                  \
+            auto *new_slots = new size_t[new_capacity];                                                                                         \
+            std::copy(deq->free_spill_slots, deq->free_spill_slots + deq->free_spill_slot_count, new_slots);                                    \
+            delete[] deq->free_spill_slots;                                                                                                     \
+            deq->free_spill_slots = new_slots;                                                                                                  \
+            deq->free_spill_slot_capacity = new_capacity;                                                                                       \
+        }                                                                                                                                       \
+        deq->free_spill_slots[deq->free_spill_slot_count++] = slot;                                                                             \
+    }                                                                                                                                           \
+    /* Function to empty the spill file once no block is spilled */                                                                             \
+    inline void reset_spill_file_segmented(Deque_##t##_Segmented *deq) {                                                                        \
+        deq->free_spill_slot_count = 0;                                                                                                         \
+        deq->spill_slot_end = 0;                                                                                                                \
+        deq->spill_cache_slot = SPILL_NO_SLOT;                                                                                                  \
+        if (ftruncate(deq->spill_fd, 0) != 0) {                                                                                                 \
+            perror("Segmented Deque spill truncate");                                                                                           \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to hint the kernel to read ahead the spilled blocks next to the resident blocks of one side */                                  \
+    inline void readahead_spill_segmented(Deque_##t##_Segmented *deq, bool front_side) {                                                        \
+        size_t spilled = spilled_blocks_segmented(deq);                                                                                         \
+        for (size_t i = 0; i < std::min(spilled, (size_t) SPILL_READAHEAD_BLOCKS); i++) {                                                       \
+            size_t position = front_side ? deq->front_resident_blocks + i : deq->block_count - deq->back_resident_blocks - 1 - i;               \
+            size_t slot = deq->spill_slot_map[(deq->map_front_index + position) & deq->map_capacity_mask];                                      \
+            posix_fadvise(deq->spill_fd, spill_offset_segmented(deq, slot), (off_t) (SEGMENT_ELEMENTS * sizeof(t)), POSIX_FADV_WILLNEED);       \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to spill middle blocks until resident blocks fit in the memory budget */                                                        \
+    /* The innermost resident block of the side holding more blocks is spilled first, so both ends stay resident */                             \
+    inline void balance_spill_segmented(Deque_##t##_Segmented *deq) {                                                                           \
+        if (spilled_blocks_segmented(deq) == 0) {                                                                                               \
+            deq->front_resident_blocks = deq->block_count / 2;                                                                                  \
+            deq->back_resident_blocks = deq->block_count - deq->front_resident_blocks;                                                          \
+        }                                                                                                                                       \
+        while (deq->front_resident_blocks + deq->back_resident_blocks > deq->spill_budget_blocks) {                                             \
+            bool back_side = deq->back_resident_blocks > deq->front_resident_blocks;                                                            \
+            size_t position = back_side ? deq->block_count - deq->back_resident_blocks : deq->front_resident_blocks - 1;                        \
+            if (!spill_block_segmented(deq, position)) {                                                                                        \
+                return;                                                                                                                         \
+            }                                                                                                                                   \
+            if (back_side) {                                                                                                                    \
+                deq->back_resident_blocks--;                                                                                                    \
+            } else {                                                                                                                            \
+                deq->front_resident_blocks--;                                                                                                   \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to page spilled blocks back in once all resident blocks of one side are popped */                                               \
+    /* Up to half of the budget is read sequentially, then the following blocks are read ahead */                                               \
+    inline void refill_spill_segmented(Deque_##t##_Segmented *deq, bool front_side) {                                                           \
+        size_t &resident_blocks = front_side ? deq->front_resident_blocks : deq->back_resident_blocks;                                          \
+        if (resident_blocks != 0 || spilled_blocks_segmented(deq) == 0) {                                                                       \
+            return;                                                                                                                             \
+        }                                                                                                                                       \
+        size_t target_blocks = std::max((size_t) 1, deq->spill_budget_blocks / 2);                                                              \
+        while (resident_blocks < target_blocks && spilled_blocks_segmented(deq) > 0) {                                                          \
+            load_block_segmented(deq, front_side ? deq->front_resident_blocks : deq->block_count - deq->back_resident_blocks - 1);              \
+            resident_blocks++;                                                                                                                  \
+        }                                                                                                                                       \
+        if (spilled_blocks_segmented(deq) == 0) {                                                                                               \
+            reset_spill_file_segmented(deq);                                                                                                    \
+        } else {                                                                                                                                \
+            readahead_spill_segmented(deq, front_side);                                                                                         \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to update resident block counts when the first or the last block is released */                                                 \
+    inline void block_released_spill_segmented(Deque_##t##_Segmented *deq, bool front_side) {                                                   \
+        size_t &resident_blocks = front_side ? deq->front_resident_blocks : deq->back_resident_blocks;                                          \
+        size_t &other_resident_blocks = front_side ? deq->back_resident_blocks : deq->front_resident_blocks;                                    \
+        /* Without spilled blocks a side may own no block at all, the other side owns the released one then */                                  \
+        if (resident_blocks > 0) {                                                                                                              \
+            resident_blocks--;                                                                                                                  \
+        } else {                                                                                                                                \
+            other_resident_blocks--;                                                                                                            \
+        }                                                                                                                                       \
+        refill_spill_segmented(deq, front_side);                                                                                                \
+    }                                                                                                                                           \
+    /* Function to push new element from front side to Segmented Deque */                                                                       \
+    inline void push_front_segmented(Deque_##t##_Segmented *deq, t new_##t) {                                                                   \
+        /* Add a block in front of the first block when it has no free slot left */                                                             \
+        if (deq->block_front_offset == 0) {                                                                                                     \
+            if (deq->block_count == deq->map_capacity) {                                                                                        \
+                dynamic_map_capacity(deq);                                                                                                      \
+            }                                                                                                                                   \
+            deq->map_front_index = (deq->map_front_index - 1) & deq->map_capacity_mask;                                                         \
+            deq->block_map[deq->map_front_index] = acquire_block_segmented(deq);                                                                \
+            deq->block_count++;                                                                                                                 \
+            deq->block_front_offset = SEGMENT_ELEMENTS;                                                                                         \
+            if (deq->spill_fd >= 0) {                                                                                                           \
+                deq->front_resident_blocks++;                                                                                                   \
+                balance_spill_segmented(deq);                                                                                                   \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+        deq->block_front_offset--;                                                                                                              \
+        deq->list_elements++;                                                                                                                   \
+        *element_segmented(deq, 0) = std::move(new_##t);                                                                                        \
+    }                                                                                                                                           \
+    /* Function to push new element from back side to Segmented Deque */                                                                        \
+    inline void push_back_segmented(Deque_##t##_Segmented *deq, t new_##t) {                                                                    \
+        /* Add a block after the last block when it has no free slot left */                                                                    \
+        if (deq->block_front_offset + deq->list_elements == (deq->block_count << SEGMENT_SHIFT)) {                                              \
+            if (deq->block_count == deq->map_capacity) {                                                                                        \
+                dynamic_map_capacity(deq);                                                                                                      \
+            }                                                                                                                                   \
+            deq->block_map[(deq->map_front_index + deq->block_count) & deq->map_capacity_mask] = acquire_block_segmented(deq);                  \
+            deq->block_count++;                                                                                                                 \
+            if (deq->spill_fd >= 0) {                                                                                                           \
+                deq->back_resident_blocks++;                                                                                                    \
+                balance_spill_segmented(deq);                                                                                                   \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+        *element_segmented(deq, deq->list_elements) = std::move(new_##t);                                                                       \
+        deq->list_elements++;                                                                                                                   \
+    }                                                                                                                                           \
+    /* Function to pop element from front side from Segmented Deque */                                                                          \
+    inline void pop_front_segmented(Deque_##t##_Segmented *deq) {                                                                               \
+        if (!list_empty(deq)) {                                                                                                                 \
+            deq->block_front_offset++;                                                                                                          \
+            deq->list_elements--;                                                                                                               \
+            /* Release first block once all of its elements are popped */                                                                       \
+            if (deq->block_front_offset == SEGMENT_ELEMENTS) {                                                                                  \
+                release_block_segmented(deq, deq->block_map[deq->map_front_index]);                                                             \
+                deq->map_front_index = (deq->map_front_index + 1) & deq->map_capacity_mask;                                                     \
+                deq->block_count--;                                                                                                             \
+                deq->block_front_offset = 0;                                                                                                    \
+                if (deq->spill_fd >= 0) {                                                                                                       \
+                    block_released_spill_segmented(deq, true);                                                                                  \
+                }                                                                                                                               \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to pop element from back side from Segmented Deque */                                                                           \
+    inline void pop_back_segmented(Deque_##t##_Segmented *deq) {                                                                                \
+        if (!list_empty(deq)) {                                                                                                                 \
+            deq->list_elements--;                                                                                                               \
+            /* Release last block once all of its elements are popped */                                                                        \
+            if (deq->block_front_offset + deq->list_elements == ((deq->block_count - 1) << SEGMENT_SHIFT)) {                                    \
+                deq->block_count--;                                                                                                             \
+                release_block_segmented(deq, deq->block_map[(deq->map_front_index + deq->block_count) & deq->map_capacity_mask]);               \
+                if (deq->block_count == 0) {                                                                                                    \
+                    deq->block_front_offset = 0;                                                                                                \
+                }                                                                                                                               \
+                if (deq->spill_fd >= 0) {                                                                                                       \
+                    block_released_spill_segmented(deq, false);                                                                                 \
+                }                                                                                                                               \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function returns element from front side from Segmented Deque */                                                                         \
+    inline t &front_segmented(Deque_##t##_Segmented *deq) {                                                                                     \
+        return *element_segmented(deq, 0);                                                                                                      \
+    }                                                                                                                                           \
+    /* Function returns element from back side from Segmented Deque */                                                                          \
+    inline t &back_segmented(Deque_##t##_Segmented *deq) {                                                                                      \
+        return *element_segmented(deq, deq->list_elements - 1);                                                                                 \
+    }                                                                                                                                           \
+    /* Function returns element at the required index from Segmented Deque */                                                                   \
+    inline t &at_segmented(Deque_##t##_Segmented *deq, size_t req_index) {                                                                      \
+        return *element_segmented(deq, req_index);                                                                                              \
+    }                                                                                                                                           \
+    /* Function to increment the iterator index by 1 */                                                                                         \
+    inline void inc_segmented(Deque_##t##_Segmented_Iterator *it) {                                                                             \
+        it->deque_##t##_index++;                                                                                                                \
+    }                                                                                                                                           \
+    /* Function to decrement the iterator index by 1 */                                                                                         \
+    inline void dec_segmented(Deque_##t##_Segmented_Iterator *it) {                                                                             \
+        it->deque_##t##_index--;                                                                                                                \
+    }                                                                                                                                           \
+    /* Function returns the element at iterator index */                                                                                        \
+    inline t &deref_segmented(Deque_##t##_Segmented_Iterator *it) {                                                                             \
+        return *element_segmented(it->deque_##t, it->deque_##t##_index);                                                                        \
+    }                                                                                                                                           \
+    /* Function returns Segmented Deque Iterator object with begin index as 0 */                                                                \
+    inline Deque_##t##_Segmented_Iterator begin_segmented(Deque_##t##_Segmented *deq) {                                                         \
+        Deque_##t##_Segmented_Iterator t##_iter{};                                                                                              \
+        t##_iter.deque_##t = deq;                                                                                                               \
+        t##_iter.deque_##t##_index = BEGIN_INDEX;                                                                                               \
+        t##_iter.dec = &dec_segmented;                                                                                                          \
+        t##_iter.deref = &deref_segmented;                                                                                                      \
+        t##_iter.inc = &inc_segmented;                                                                                                          \
+        return t##_iter;                                                                                                                        \
+    }                                                                                                                                           \
+    /* Function returns Segmented Deque Iterator object with end index as number of elements */                                                 \
+    inline Deque_##t##_Segmented_Iterator end_segmented(Deque_##t##_Segmented *deq) {                                                           \
+        Deque_##t##_Segmented_Iterator t##_iter{};                                                                                              \
+        t##_iter.deque_##t = deq;                                                                                                               \
+        t##_iter.deque_##t##_index = deq->list_elements;                                                                                        \
+        t##_iter.dec = &dec_segmented;                                                                                                          \
+        t##_iter.deref = &deref_segmented;                                                                                                      \
+        t##_iter.inc = &inc_segmented;                                                                                                          \
+        return t##_iter;                                                                                                                        \
+    }                                                                                                                                           \
+    /* Function returns true when passed argument are equal otherwise false */                                                                  \
+    inline bool Deque_##t##_Segmented_Iterator_equal(Deque_##t##_Segmented_Iterator start, Deque_##t##_Segmented_Iterator end) {                \
+        return (start.deque_##t##_index == end.deque_##t##_index);                                                                              \
+    }                                                                                                                                           \
+    /* Function returns true when both Segmented Deques are same otherwise false */                                                             \
+    /* Deques are taken by reference, a copy would share the spill cache block but not the slot it holds */                                     \
+    inline bool Deque_##t##_Segmented_equal(Deque_##t##_Segmented &deq1, Deque_##t##_Segmented &deq2) {                                         \
+        /* Both parameters should have same number of elements */                                                                               \
+        if (deq1.list_elements != deq2.list_elements) {                                                                                         \
+            return false;                                                                                                                       \
+        }                                                                                                                                       \
+        /* Elements should be present at the same index in respective Segmented Deque */                                                        \
+        for (size_t i = 0; i < deq1.list_elements; i++) {                                                                                       \
+            t t##_1 = at_segmented(&deq1, i);                                                                                                   \
+            t t##_2 = at_segmented(&deq2, i);                                                                                                   \
+            if (deq1.compare_elements(t##_1, t##_2) || deq2.compare_elements(t##_2, t##_1)) {                                                   \
+                return false;                                                                                                                   \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to release all blocks and reset indexes as it was during constructing the Segmented Deque */                                    \
+    inline void clear_segmented(Deque_##t##_Segmented *deq) {                                                                                   \
+        for (size_t i = 0; i < deq->block_count; i++) {                                                                                         \
+            release_block_segmented(deq, deq->block_map[(deq->map_front_index + i) & deq->map_capacity_mask]);                                  \
+        }                                                                                                                                       \
+        deq->map_front_index = 0;                                                                                                               \
+        deq->block_count = 0;                                                                                                                   \
+        deq->block_front_offset = 0;                                                                                                            \
+        deq->list_elements = 0;                                                                                                                 \
+        if (deq->spill_fd >= 0) {                                                                                                               \
+            deq->front_resident_blocks = 0;                                                                                                     \
+            deq->back_resident_blocks = 0;                                                                                                      \
+            reset_spill_file_segmented(deq);                                                                                                    \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to deallocate all the heap memory allocations for Segmented Deque (and close the spill file) */                                 \
+    inline void dtor_segmented(Deque_##t##_Segmented *deq) {                                                                                    \
+        clear_segmented(deq);                                                                                                                   \
+        delete[] deq->spare_block;                                                                                                              \
+        deq->spare_block = nullptr;                                                                                                             \
+        if (deq->spill_fd >= 0) {                                                                                                               \
+            close(deq->spill_fd);                                                                                                               \
+            deq->spill_fd = -1;                                                                                                                 \
+        }                                                                                                                                       \
+        delete[] deq->spill_slot_map;                                                                                                           \
+        deq->spill_slot_map = nullptr;                                                                                                          \
+        delete[] deq->free_spill_slots;                                                                                                         \
+        deq->free_spill_slots = nullptr;                                                                                                        \
+        delete[] deq->spill_cache_block;                                                                                                        \
+        deq->spill_cache_block = nullptr;                                                                                                       \
+        delete[] deq->block_map;                                                                                                                \
+        deq->block_map = nullptr;                                                                                                               \
+    }                                                                                                                                           \
+    /* Function to sort elements of Segmented Deque according to respective compare functions */                                                \
+    inline void sort_segmented(Deque_##t##_Segmented *deq, Deque_##t##_Segmented_Iterator begin, Deque_##t##_Segmented_Iterator end) {          \
+        size_t i, begin_index = begin.deque_##t##_index;                                                                                        \
+        size_t sort_list_size = end.deque_##t##_index - begin_index;                                                                            \
+        t *sorted_list = new t[sort_list_size];                                                                                                 \
+        /* Logic to copy elements according to passed begin and end iterators */                                                                \
+        for (i = 0; i < sort_list_size; i++) {                                                                                                  \
+            sorted_list[i] = *element_segmented(deq, begin_index + i);                                                                          \
+        }                                                                                                                                       \
+        /* Sorting of elements using C++ standard library std::sort(array, size, compare) */                                                    \
+        sort(sorted_list, sorted_list + sort_list_size, deq->compare_elements);                                                                 \
+        /* Copying back the sorted elements in the original Segmented Deque at respective indexes */                                            \
+        for (i = 0; i < sort_list_size; i++) {                                                                                                  \
+            *element_segmented(deq, begin_index + i) = sorted_list[i];                                                                          \
+        }                                                                                                                                       \
+        delete[] sorted_list;                                                                                                                   \
+    }                                                                                                                                           \
+    /* Function to turn on spill mode, keeping about memory_budget bytes of blocks in memory (t must be trivially copyable) */                  \
+    /* The spill file at path is created and unlinked right away, so it is removed once the Segmented Deque closes it */                        \
+    /* Returns 0 on success, or -1 with errno set (EINVAL for other types of t, EBUSY if spill mode is already on) */                           \
+    inline int spill_to_segmented(Deque_##t##_Segmented *deq, const char *path, size_t memory_budget) {                                         \
+        if (!is_trivially_copyable<t>::value) {                                                                                                 \
+            errno = EINVAL;                                                                                                                     \
+            return -1;                                                                                                                          \
+        }                                                                                                                                       \
+        if (deq->spill_fd >= 0) {                                                                                                               \
+            errno = EBUSY;                                                                                                                      \
+            return -1;                                                                                                                          \
+        }                                                                                                                                       \
+        int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);                                                                      \
+        if (fd < 0) {                                                                                                                           \
+            return -1;                                                                                                                          \
+        }                                                                                                                                       \
+        unlink(path);                                                                                                                           \
+        deq->spill_fd = fd;                                                                                                                     \
+        deq->spill_budget_blocks = std::max((size_t) SPILL_MIN_BLOCKS, memory_budget / (SEGMENT_ELEMENTS * sizeof(t)));                         \
+        deq->spill_slot_map = new size_t[deq->map_capacity];                                                                                    \
+        deq->spill_cache_block = new t[SEGMENT_ELEMENTS];                                                                                       \
+        deq->spill_cache_slot = SPILL_NO_SLOT;                                                                                                  \
+        deq->front_resident_blocks = 0;                                                                                                         \
+        deq->back_resident_blocks = deq->block_count;                                                                                           \
+        balance_spill_segmented(deq);                                                                                                           \
+        return 0;                                                                                                                               \
+    }                                                                                                                                           \
+    /* Direct-call API matching the one of Deque_Custom */                                                                                      \
+    inline size_t Deque_##t##_Segmented_size(Deque_##t##_Segmented *deq) {                                                                      \
+        return list_size(deq);                                                                                                                  \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_Segmented_empty(Deque_##t##_Segmented *deq) {                                                                       \
+        return list_empty(deq);                                                                                                                 \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_push_front(Deque_##t##_Segmented *deq, t new_##t) {                                                       \
+        push_front_segmented(deq, std::move(new_##t));                                                                                          \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_push_back(Deque_##t##_Segmented *deq, t new_##t) {                                                        \
+        push_back_segmented(deq, std::move(new_##t));                                                                                           \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_pop_front(Deque_##t##_Segmented *deq) {                                                                   \
+        pop_front_segmented(deq);                                                                                                               \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_pop_back(Deque_##t##_Segmented *deq) {                                                                    \
+        pop_back_segmented(deq);                                                                                                                \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_Segmented_front(Deque_##t##_Segmented *deq) {                                                                         \
+        return front_segmented(deq);                                                                                                            \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_Segmented_back(Deque_##t##_Segmented *deq) {                                                                          \
+        return back_segmented(deq);                                                                                                             \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_Segmented_at(Deque_##t##_Segmented *deq, size_t req_index) {                                                          \
+        return at_segmented(deq, req_index);                                                                                                    \
+    }                                                                                                                                           \
+    inline Deque_##t##_Segmented_Iterator Deque_##t##_Segmented_begin(Deque_##t##_Segmented *deq) {                                             \
+        return begin_segmented(deq);                                                                                                            \
+    }                                                                                                                                           \
+    inline Deque_##t##_Segmented_Iterator Deque_##t##_Segmented_end(Deque_##t##_Segmented *deq) {                                               \
+        return end_segmented(deq);                                                                                                              \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_clear(Deque_##t##_Segmented *deq) {                                                                       \
+        clear_segmented(deq);                                                                                                                   \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_dtor(Deque_##t##_Segmented *deq) {                                                                        \
+        dtor_segmented(deq);                                                                                                                    \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_sort(Deque_##t##_Segmented *deq, Deque_##t##_Segmented_Iterator begin, Deque_##t##_Segmented_Iterator end) { \
+        sort_segmented(deq, begin, end);                                                                                                        \
+    }                                                                                                                                           \
+    inline int Deque_##t##_Segmented_spill_to(Deque_##t##_Segmented *deq, const char *path, size_t memory_budget) {                             \
+        return spill_to_segmented(deq, path, memory_budget);                                                                                    \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_Iterator_inc(Deque_##t##_Segmented_Iterator *it) {                                                        \
+        inc_segmented(it);                                                                                                                      \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Segmented_Iterator_dec(Deque_##t##_Segmented_Iterator *it) {                                                        \
+        dec_segmented(it);                                                                                                                      \
+    }                                                                                                                                           \
+    inline t &Deque_##t##_Segmented_Iterator_deref(Deque_##t##_Segmented_Iterator *it) {                                                        \
+        return deref_segmented(it);                                                                                                             \
+    }                                                                                                                                           \
+    /* Function to construct the Segmented Deque structure for the first time (blocks are allocated on first push) */                           \
+    inline void Deque_##t##_Segmented_ctor(Deque_##t##_Segmented *deq, bool (*compare_lists)(const t &o1, const t &o2)) {                       \
+        /* Memory allocation for block map with static size */                                                                                  \
+        deq->block_map = new t *[BLOCK_MAP_CAPACITY];                                                                                           \
+        /* Logic if Heap memory allocated correctly */                                                                                          \
+        if (deq->block_map != nullptr) {                                                                                                        \
+            strcpy(deq->type_name, ("Deque_" #t "_Segmented"));                                                                                 \
+            deq->spare_block = nullptr;                                                                                                         \
+            deq->map_capacity = BLOCK_MAP_CAPACITY;                                                                                             \
+            deq->map_capacity_mask = BLOCK_MAP_CAPACITY - 1;                                                                                    \
+            deq->map_front_index = 0;                                                                                                           \
+            deq->block_count = 0;                                                                                                               \
+            deq->block_front_offset = 0;                                                                                                        \
+            deq->list_elements = 0;                                                                                                             \
+            deq->spill_fd = -1;                                                                                                                 \
+            deq->spill_budget_blocks = 0;                                                                                                       \
+            deq->front_resident_blocks = 0;                                                                                                     \
+            deq->back_resident_blocks = 0;                                                                                                      \
+            deq->spill_slot_map = nullptr;                                                                                                      \
+            deq->free_spill_slots = nullptr;                                                                                                    \
+            deq->free_spill_slot_count = 0;                                                                                                     \
+            deq->free_spill_slot_capacity = 0;                                                                                                  \
+            deq->spill_slot_end = 0;                                                                                                            \
+            deq->spill_cache_block = nullptr;                                                                                                   \
+            deq->spill_cache_slot = SPILL_NO_SLOT;                                                                                              \
+            /* Initialization of function pointers */                                                                                           \
+            deq->size = list_size;                                                                                                              \
+            deq->empty = list_empty;                                                                                                            \
+            deq->push_back = &push_back_segmented;                                                                                              \
+            deq->push_front = &push_front_segmented;                                                                                            \
+            deq->pop_back = &pop_back_segmented;                                                                                                \
+            deq->pop_front = &pop_front_segmented;                                                                                              \
+            deq->front = &front_segmented;                                                                                                      \
+            deq->back = &back_segmented;                                                                                                        \
+            deq->at = &at_segmented;                                                                                                            \
+            deq->begin = &begin_segmented;                                                                                                      \
+            deq->end = &end_segmented;                                                                                                          \
+            deq->clear = &clear_segmented;                                                                                                      \
+            deq->dtor = &dtor_segmented;                                                                                                        \
+            deq->compare_elements = compare_lists;                                                                                              \
+            deq->sort = sort_segmented;                                                                                                         \
+            deq->spill_to = &spill_to_segmented;                                                                                                \
+        }                                                                                                                                       \
+    }
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef NITESH_SPSC_DEQUE_H
+#define NITESH_SPSC_DEQUE_H
+
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include "deque.hpp"
+
+#define CACHE_LINE_SIZE 64
+
+/*
+ * Macro to implement methods related to bounded Single Producer Single Consumer Deque using Stringification
+ * One thread pushes to the back while another thread pops from the front, without locks.
+ * Positions are free running counters, element of position p is stored at index p & mask.
+ * Each side owns one index (on its own cache line) and keeps a cached copy of the other side's index,
+ * so the shared index is read only when the cached copy says the ring looks full (or empty).
+ * Batch functions publish or consume many elements with a single release store.
+ */
+#define Deque_SPSC_Custom(t)                                                                                                                    \
+    using namespace std;                                                                                                                        \
+    /* Structure to represent SPSC Deque */                                                                                                     \
+    struct Deque_##t##_SPSC {                                                                                                                   \
+        /* Variable declaration for SPSC Deque (read only after construction) */                                                                \
+        char type_name[(sizeof "Deque_") + (sizeof #t) + (sizeof "_SPSC") - 2];                                                                 \
+        t *t##_list;                                                                                                                            \
+        size_t list_capacity;                                                                                                                   \
+        size_t list_capacity_mask;                                                                                                              \
+        /* Function Pointer declaration for SPSC Deque */                                                                                       \
+        size_t (*size)(Deque_##t##_SPSC *deq);                                                                                                  \
+        bool (*empty)(Deque_##t##_SPSC *deq);                                                                                                   \
+        bool (*try_push_back)(Deque_##t##_SPSC *deq, t);                                                                                        \
+        size_t (*try_push_back_n)(Deque_##t##_SPSC *deq, const t *src, size_t count);                                                           \
+        bool (*try_pop_front)(Deque_##t##_SPSC *deq, t *dst);                                                                                   \
+        size_t (*try_pop_front_n)(Deque_##t##_SPSC *deq, t *dst, size_t count);                                                                 \
+        void (*dtor)(Deque_##t##_SPSC *deq);                                                                                                    \
+        /* Producer side: back position written by producer and its cached copy of front position */                                            \
+        alignas(CACHE_LINE_SIZE) atomic<size_t> list_back_position;                                                                             \
+        size_t cached_front_position;                                                                                                           \
+        /* Consumer side: front position written by consumer and its cached copy of back position */                                            \
+        alignas(CACHE_LINE_SIZE) atomic<size_t> list_front_position;                                                                            \
+        size_t cached_back_position;                                                                                                            \
+    };                                                                                                                                          \
+    /* Typedef for SPSC Deque struct */                                                                                                         \
+    typedef struct Deque_##t##_SPSC Deque_##t##_SPSC;                                                                                           \
+    /* Function returns number of elements present in SPSC Deque (exact only when both sides are idle) */                                       \
+    inline size_t list_size(Deque_##t##_SPSC *deq) {                                                                                            \
+        size_t front_position = deq->list_front_position.load(memory_order_acquire);                                                            \
+        return deq->list_back_position.load(memory_order_acquire) - front_position;                                                             \
+    }                                                                                                                                           \
+    /* Function returns true if SPSC Deque is empty otherwise false */                                                                          \
+    inline bool list_empty(Deque_##t##_SPSC *deq) {                                                                                             \
+        return (list_size(deq) == 0);                                                                                                           \
+    }                                                                                                                                           \
+    /* Function to copy count elements into the ring starting at position (producer only, at most two runs) */                                  \
+    inline void copy_to_ring_spsc(Deque_##t##_SPSC *deq, size_t position, const t *src, size_t count) {                                         \
+        size_t index = position & deq->list_capacity_mask;                                                                                      \
+        size_t first_run = std::min(count, deq->list_capacity - index);                                                                         \
+        std::copy(src, src + first_run, deq->t##_list + index);                                                                                 \
+        std::copy(src + first_run, src + count, deq->t##_list);                                                                                 \
+    }                                                                                                                                           \
+    /* Function to copy count elements out of the ring starting at position (consumer only, at most two runs) */                                \
+    inline void copy_from_ring_spsc(Deque_##t##_SPSC *deq, size_t position, t *dst, size_t count) {                                             \
+        size_t index = position & deq->list_capacity_mask;                                                                                      \
+        size_t first_run = std::min(count, deq->list_capacity - index);                                                                         \
+        std::copy(deq->t##_list + index, deq->t##_list + index + first_run, dst);                                                               \
+        std::copy(deq->t##_list, deq->t##_list + (count - first_run), dst + first_run);                                                         \
+    }                                                                                                                                           \
+    /* Function returns number of free slots seen by producer, reloading front position only if needed */                                       \
+    inline size_t free_slots_spsc(Deque_##t##_SPSC *deq, size_t back_position, size_t wanted) {                                                 \
+        size_t free_slots = deq->list_capacity - (back_position - deq->cached_front_position);                                                  \
+        if (free_slots < wanted) {                                                                                                              \
+            deq->cached_front_position = deq->list_front_position.load(memory_order_acquire);                                                   \
+            free_slots = deq->list_capacity - (back_position - deq->cached_front_position);                                                     \
+        }                                                                                                                                       \
+        return free_slots;                                                                                                                      \
+    }                                                                                                                                           \
+    /* Function returns number of elements seen by consumer, reloading back position only if needed */                                          \
+    inline size_t ready_elements_spsc(Deque_##t##_SPSC *deq, size_t front_position, size_t wanted) {                                            \
+        size_t ready = deq->cached_back_position - front_position;                                                                              \
+        if (ready < wanted) {                                                                                                                   \
+            deq->cached_back_position = deq->list_back_position.load(memory_order_acquire);                                                     \
+            ready = deq->cached_back_position - front_position;                                                                                 \
+        }                                                                                                                                       \
+        return ready;                                                                                                                           \
+    }                                                                                                                                           \
+    /* Function to push new element to back side of SPSC Deque, returns false if it is full (producer only) */                                  \
+    inline bool try_push_back_spsc(Deque_##t##_SPSC *deq, t new_##t) {                                                                          \
+        size_t back_position = deq->list_back_position.load(memory_order_relaxed);                                                              \
+        if (free_slots_spsc(deq, back_position, 1) == 0) {                                                                                      \
+            return false;                                                                                                                       \
+        }                                                                                                                                       \
+        deq->t##_list[back_position & deq->list_capacity_mask] = std::move(new_##t);                                                            \
+        deq->list_back_position.store(back_position + 1, memory_order_release);                                                                 \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to push up to count elements of src to back side of SPSC Deque, returns number of pushed elements */                            \
+    inline size_t try_push_back_n_spsc(Deque_##t##_SPSC *deq, const t *src, size_t count) {                                                     \
+        size_t back_position = deq->list_back_position.load(memory_order_relaxed);                                                              \
+        count = std::min(count, free_slots_spsc(deq, back_position, count));                                                                    \
+        if (count != 0) {                                                                                                                       \
+            copy_to_ring_spsc(deq, back_position, src, count);                                                                                  \
+            deq->list_back_position.store(back_position + count, memory_order_release);                                                         \
+        }                                                                                                                                       \
+        return count;                                                                                                                           \
+    }                                                                                                                                           \
+    /* Function to pop element from front side of SPSC Deque into dst, returns false if it is empty (consumer only) */                          \
+    inline bool try_pop_front_spsc(Deque_##t##_SPSC *deq, t *dst) {                                                                             \
+        size_t front_position = deq->list_front_position.load(memory_order_relaxed);                                                            \
+        if (ready_elements_spsc(deq, front_position, 1) == 0) {                                                                                 \
+            return false;                                                                                                                       \
+        }                                                                                                                                       \
+        *dst = deq->t##_list[front_position & deq->list_capacity_mask];                                                                         \
+        deq->list_front_position.store(front_position + 1, memory_order_release);                                                               \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to pop up to count elements from front side of SPSC Deque into dst, returns number of popped elements */                        \
+    inline size_t try_pop_front_n_spsc(Deque_##t##_SPSC *deq, t *dst, size_t count) {                                                           \
+        size_t front_position = deq->list_front_position.load(memory_order_relaxed);                                                            \
+        count = std::min(count, ready_elements_spsc(deq, front_position, count));                                                               \
+        if (count != 0) {                                                                                                                       \
+            copy_from_ring_spsc(deq, front_position, dst, count);                                                                               \
+            deq->list_front_position.store(front_position + count, memory_order_release);                                                       \
+        }                                                                                                                                       \
+        return count;                                                                                                                           \
+    }                                                                                                                                           \
+    /* Function to deallocate all the heap memory allocations for SPSC Deque */                                                                 \
+    inline void dtor_spsc(Deque_##t##_SPSC *deq) {                                                                                              \
+        delete[] deq->t##_list;                                                                                                                 \
+        deq->t##_list = nullptr;                                                                                                                \
+    }                                                                                                                                           \
+    /* Direct-call API matching the one of Deque_Custom */                                                                                      \
+    inline size_t Deque_##t##_SPSC_size(Deque_##t##_SPSC *deq) {                                                                                \
+        return list_size(deq);                                                                                                                  \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_SPSC_empty(Deque_##t##_SPSC *deq) {                                                                                 \
+        return list_empty(deq);                                                                                                                 \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_SPSC_try_push_back(Deque_##t##_SPSC *deq, t new_##t) {                                                              \
+        return try_push_back_spsc(deq, std::move(new_##t));                                                                                     \
+    }                                                                                                                                           \
+    inline size_t Deque_##t##_SPSC_try_push_back_n(Deque_##t##_SPSC *deq, const t *src, size_t count) {                                         \
+        return try_push_back_n_spsc(deq, src, count);                                                                                           \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_SPSC_try_pop_front(Deque_##t##_SPSC *deq, t *dst) {                                                                 \
+        return try_pop_front_spsc(deq, dst);                                                                                                    \
+    }                                                                                                                                           \
+    inline size_t Deque_##t##_SPSC_try_pop_front_n(Deque_##t##_SPSC *deq, t *dst, size_t count) {                                               \
+        return try_pop_front_n_spsc(deq, dst, count);                                                                                           \
+    }                                                                                                                                           \
+    inline void Deque_##t##_SPSC_dtor(Deque_##t##_SPSC *deq) {                                                                                  \
+        dtor_spsc(deq);                                                                                                                         \
+    }                                                                                                                                           \
+    /* Function to construct the SPSC Deque with capacity rounded up to a power of two (must not be shared yet) */                              \
+    inline void Deque_##t##_SPSC_ctor(Deque_##t##_SPSC *deq, size_t capacity) {                                                                 \
+        size_t list_capacity = LIST_CAPACITY;                                                                                                   \
+        while (list_capacity < capacity) {                                                                                                      \
+            list_capacity *= DOUBLE;                                                                                                            \
+        }                                                                                                                                       \
+        /* Memory allocation for t_list with fixed size */                                                                                      \
+        deq->t##_list = new t[list_capacity];                                                                                                   \
+        /* Logic if Heap memory allocated correctly */                                                                                          \
+        if (deq->t##_list != nullptr) {                                                                                                         \
+            strcpy(deq->type_name, ("Deque_" #t "_SPSC"));                                                                                      \
+            deq->list_capacity = list_capacity;                                                                                                 \
+            deq->list_capacity_mask = list_capacity - 1;                                                                                        \
+            deq->list_back_position.store(0, memory_order_relaxed);                                                                             \
+            deq->cached_front_position = 0;                                                                                                     \
+            deq->list_front_position.store(0, memory_order_relaxed);                                                                            \
+            deq->cached_back_position = 0;                                                                                                      \
+            /* Initialization of function pointers */                                                                                           \
+            deq->size = list_size;                                                                                                              \
+            deq->empty = list_empty;                                                                                                            \
+            deq->try_push_back = &try_push_back_spsc;                                                                                           \
+            deq->try_push_back_n = &try_push_back_n_spsc;                                                                                       \
+            deq->try_pop_front = &try_pop_front_spsc;                                                                                           \
+            deq->try_pop_front_n = &try_pop_front_n_spsc;                                                                                       \
+            deq->dtor = &dtor_spsc;                                                                                                             \
+        }                                                                                                                                       \
+    }
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef NITESH_WINDOW_DEQUE_H
+#define NITESH_WINDOW_DEQUE_H
+
+#include <cstring>
+#include <type_traits>
+#include "deque.hpp"
+
+/*
+ * Type of the running sum of a window of T (wide integers for integral T, double for floating point T)
+ */
+template<typename T, bool = std::is_integral<T>::value, bool = std::is_floating_point<T>::value>
+struct DequeWindowSum {
+    typedef T type;
+};
+
+template<typename T>
+struct DequeWindowSum<T, true, false> {
+    typedef typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type type;
+};
+
+template<typename T>
+struct DequeWindowSum<T, false, true> {
+    typedef double type;
+};
+
+/*
+ * Macro to implement sliding window over samples of type t using Stringification
+ * Samples are pushed at the back with a time stamp and expire from the front once the window holds more than
+ * max_samples of them or they are older than max_age. Min and max are kept in monotonic deques of candidates:
+ * a sample is dropped from the back of the min candidates as soon as a newer sample is not greater
+ * (and from the max candidates as soon as a newer sample is not smaller), so the front candidate is always the answer
+ * and every sample enters and leaves each deque once. Samples are stored in a Deque generated by Deque_Custom.
+ * t needs + and - for the running sum.
+ */
+#define Deque_Window_Custom(t)                                                                                                                  \
+    using namespace std;                                                                                                                        \
+    /* Structure to represent sample of Window Deque (sequence number identifies the sample among candidates) */                                \
+    struct Deque_##t##_Window_Entry {                                                                                                           \
+        t value;                                                                                                                                \
+        long long time;                                                                                                                         \
+        size_t sequence;                                                                                                                        \
+    };                                                                                                                                          \
+    typedef struct Deque_##t##_Window_Entry Deque_##t##_Window_Entry;                                                                           \
+    inline bool Deque_##t##_Window_Entry_less(const Deque_##t##_Window_Entry &o1, const Deque_##t##_Window_Entry &o2) {                         \
+        return o1.sequence < o2.sequence;                                                                                                       \
+    }                                                                                                                                           \
+    Deque_Custom(Deque_##t##_Window_Entry)                                                                                                      \
+    /* Structure to represent Window Deque */                                                                                                   \
+    struct Deque_##t##_Window {                                                                                                                 \
+        /* Variable declaration for Window Deque */                                                                                             \
+        char type_name[(sizeof "Deque_") + (sizeof #t) + (sizeof "_Window") - 2];                                                               \
+        Deque_Deque_##t##_Window_Entry samples;                                                                                                 \
+        Deque_Deque_##t##_Window_Entry min_candidates;                                                                                          \
+        Deque_Deque_##t##_Window_Entry max_candidates;                                                                                          \
+        size_t max_samples;                                                                                                                     \
+        long long max_age;                                                                                                                      \
+        size_t next_sequence;                                                                                                                   \
+        DequeWindowSum<t>::type window_sum;                                                                                                     \
+        /* Function Pointer declaration for Window Deque */                                                                                     \
+        size_t (*size)(Deque_##t##_Window *win);                                                                                                \
+        bool (*empty)(Deque_##t##_Window *win);                                                                                                 \
+        void (*push)(Deque_##t##_Window *win, t value, long long time);                                                                         \
+        void (*expire)(Deque_##t##_Window *win, long long now);                                                                                 \
+        const t &(*min)(Deque_##t##_Window *win);                                                                                               \
+        const t &(*max)(Deque_##t##_Window *win);                                                                                               \
+        DequeWindowSum<t>::type (*sum)(Deque_##t##_Window *win);                                                                                \
+        void (*clear)(Deque_##t##_Window *win);                                                                                                 \
+        void (*dtor)(Deque_##t##_Window *win);                                                                                                  \
+        bool (*compare_elements)(const t &o1, const t &o2);                                                                                     \
+    };                                                                                                                                          \
+    /* Typedef for Window Deque struct */                                                                                                       \
+    typedef struct Deque_##t##_Window Deque_##t##_Window;                                                                                       \
+    /* Function returns number of samples present in Window Deque */                                                                            \
+    inline size_t list_size(Deque_##t##_Window *win) {                                                                                          \
+        return Deque_Deque_##t##_Window_Entry_size(&win->samples);                                                                              \
+    }                                                                                                                                           \
+    /* Function returns true if Window Deque is empty otherwise false */                                                                        \
+    inline bool list_empty(Deque_##t##_Window *win) {                                                                                           \
+        return Deque_Deque_##t##_Window_Entry_empty(&win->samples);                                                                             \
+    }                                                                                                                                           \
+    /* Function to drop the oldest sample of Window Deque together with its min and max candidates */                                           \
+    inline void pop_front_window(Deque_##t##_Window *win) {                                                                                     \
+        Deque_##t##_Window_Entry &oldest = Deque_Deque_##t##_Window_Entry_front(&win->samples);                                                 \
+        win->window_sum -= oldest.value;                                                                                                        \
+        if (Deque_Deque_##t##_Window_Entry_front(&win->min_candidates).sequence == oldest.sequence) {                                           \
+            Deque_Deque_##t##_Window_Entry_pop_front(&win->min_candidates);                                                                     \
+        }                                                                                                                                       \
+        if (Deque_Deque_##t##_Window_Entry_front(&win->max_candidates).sequence == oldest.sequence) {                                           \
+            Deque_Deque_##t##_Window_Entry_pop_front(&win->max_candidates);                                                                     \
+        }                                                                                                                                       \
+        Deque_Deque_##t##_Window_Entry_pop_front(&win->samples);                                                                                \
+    }                                                                                                                                           \
+    /* Function to expire samples which are max_age or older at time now (nothing expires when max_age is 0) */                                 \
+    inline void expire_window(Deque_##t##_Window *win, long long now) {                                                                         \
+        if (win->max_age > 0) {                                                                                                                 \
+            while (!list_empty(win) && now - Deque_Deque_##t##_Window_Entry_front(&win->samples).time >= win->max_age) {                        \
+                pop_front_window(win);                                                                                                          \
+            }                                                                                                                                   \
+        }                                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to push new sample taken at time (not older than the previous one) and expire old samples */                                    \
+    inline void push_window(Deque_##t##_Window *win, t value, long long time) {                                                                 \
+        Deque_##t##_Window_Entry entry{value, time, win->next_sequence++};                                                                      \
+        /* Candidates which can no longer be the minimum (or maximum) of the window are dropped from the back */                                \
+        while (!Deque_Deque_##t##_Window_Entry_empty(&win->min_candidates) &&                                                                   \
+               !win->compare_elements(Deque_Deque_##t##_Window_Entry_back(&win->min_candidates).value, value)) {                                \
+            Deque_Deque_##t##_Window_Entry_pop_back(&win->min_candidates);                                                                      \
+        }                                                                                                                                       \
+        Deque_Deque_##t##_Window_Entry_push_back(&win->min_candidates, entry);                                                                  \
+        while (!Deque_Deque_##t##_Window_Entry_empty(&win->max_candidates) &&                                                                   \
+               !win->compare_elements(value, Deque_Deque_##t##_Window_Entry_back(&win->max_candidates).value)) {                                \
+            Deque_Deque_##t##_Window_Entry_pop_back(&win->max_candidates);                                                                      \
+        }                                                                                                                                       \
+        Deque_Deque_##t##_Window_Entry_push_back(&win->max_candidates, entry);                                                                  \
+        Deque_Deque_##t##_Window_Entry_push_back(&win->samples, entry);                                                                         \
+        win->window_sum += value;                                                                                                               \
+        if (win->max_samples != 0 && list_size(win) > win->max_samples) {                                                                       \
+            pop_front_window(win);                                                                                                              \
+        }                                                                                                                                       \
+        expire_window(win, time);                                                                                                               \
+    }                                                                                                                                           \
+    /* Function returns the smallest sample of Window Deque (window must not be empty) */                                                       \
+    inline const t &min_window(Deque_##t##_Window *win) {                                                                                       \
+        return Deque_Deque_##t##_Window_Entry_front(&win->min_candidates).value;                                                                \
+    }                                                                                                                                           \
+    /* Function returns the largest sample of Window Deque (window must not be empty) */                                                        \
+    inline const t &max_window(Deque_##t##_Window *win) {                                                                                       \
+        return Deque_Deque_##t##_Window_Entry_front(&win->max_candidates).value;                                                                \
+    }                                                                                                                                           \
+    /* Function returns sum of all samples of Window Deque */                                                                                   \
+    inline DequeWindowSum<t>::type sum_window(Deque_##t##_Window *win) {                                                                        \
+        return win->window_sum;                                                                                                                 \
+    }                                                                                                                                           \
+    /* Function to remove all samples of Window Deque */                                                                                        \
+    inline void clear_window(Deque_##t##_Window *win) {                                                                                         \
+        Deque_Deque_##t##_Window_Entry_clear(&win->samples);                                                                                    \
+        Deque_Deque_##t##_Window_Entry_clear(&win->min_candidates);                                                                             \
+        Deque_Deque_##t##_Window_Entry_clear(&win->max_candidates);                                                                             \
+        win->window_sum = DequeWindowSum<t>::type();                                                                                            \
+    }                                                                                                                                           \
+    /* Function to deallocate all the heap memory allocations for Window Deque */                                                               \
+    inline void dtor_window(Deque_##t##_Window *win) {                                                                                          \
+        Deque_Deque_##t##_Window_Entry_dtor(&win->samples);                                                                                     \
+        Deque_Deque_##t##_Window_Entry_dtor(&win->min_candidates);                                                                              \
+        Deque_Deque_##t##_Window_Entry_dtor(&win->max_candidates);                                                                              \
+    }                                                                                                                                           \
+    /* Direct-call API matching the one of Deque_Custom */                                                                                      \
+    inline size_t Deque_##t##_Window_size(Deque_##t##_Window *win) {                                                                            \
+        return list_size(win);                                                                                                                  \
+    }                                                                                                                                           \
+    inline bool Deque_##t##_Window_empty(Deque_##t##_Window *win) {                                                                             \
+        return list_empty(win);                                                                                                                 \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Window_push(Deque_##t##_Window *win, t value, long long time) {                                                     \
+        push_window(win, value, time);                                                                                                          \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Window_expire(Deque_##t##_Window *win, long long now) {                                                             \
+        expire_window(win, now);                                                                                                                \
+    }                                                                                                                                           \
+    inline const t &Deque_##t##_Window_min(Deque_##t##_Window *win) {                                                                           \
+        return min_window(win);                                                                                                                 \
+    }                                                                                                                                           \
+    inline const t &Deque_##t##_Window_max(Deque_##t##_Window *win) {                                                                           \
+        return max_window(win);                                                                                                                 \
+    }                                                                                                                                           \
+    inline DequeWindowSum<t>::type Deque_##t##_Window_sum(Deque_##t##_Window *win) {                                                            \
+        return sum_window(win);                                                                                                                 \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Window_clear(Deque_##t##_Window *win) {                                                                             \
+        clear_window(win);                                                                                                                      \
+    }                                                                                                                                           \
+    inline void Deque_##t##_Window_dtor(Deque_##t##_Window *win) {                                                                              \
+        dtor_window(win);                                                                                                                       \
+    }                                                                                                                                           \
+    /* Function to construct the Window Deque keeping at most max_samples samples (0 means no limit) */                                         \
+    /* which are younger than max_age (0 means samples never expire by time) */                                                                 \
+    inline void Deque_##t##_Window_ctor(Deque_##t##_Window *win, size_t max_samples, long long max_age,                                         \
+                                        bool (*compare_lists)(const t &o1, const t &o2)) {                                                      \
+        Deque_Deque_##t##_Window_Entry_ctor(&win->samples, Deque_##t##_Window_Entry_less);                                                      \
+        Deque_Deque_##t##_Window_Entry_ctor(&win->min_candidates, Deque_##t##_Window_Entry_less);                                               \
+        Deque_Deque_##t##_Window_Entry_ctor(&win->max_candidates, Deque_##t##_Window_Entry_less);                                               \
+        strcpy(win->type_name, ("Deque_" #t "_Window"));                                                                                        \
+        win->max_samples = max_samples;                                                                                                         \
+        win->max_age = max_age;                                                                                                                 \
+        win->next_sequence = 0;                                                                                                                 \
+        win->window_sum = DequeWindowSum<t>::type();                                                                                            \
+        /* Initialization of function pointers */                                                                                               \
+        win->size = list_size;                                                                                                                  \
+        win->empty = list_empty;                                                                                                                \
+        win->push = &push_window;                                                                                                               \
+        win->expire = &expire_window;                                                                                                           \
+        win->min = &min_window;                                                                                                                 \
+        win->max = &max_window;                                                                                                                 \
+        win->sum = &sum_window;                                                                                                                 \
+        win->clear = &clear_window;                                                                                                             \
+        win->dtor = &dtor_window;                                                                                                               \
+        win->compare_elements = compare_lists;                                                                                                  \
+    }
+
+#endif
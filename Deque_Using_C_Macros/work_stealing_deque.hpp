@@ -0,0 +1,184 @@
+#ifndef NITESH_WORK_STEALING_DEQUE_H
+#define NITESH_WORK_STEALING_DEQUE_H
+
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include "deque.hpp"
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+/*
+ * Macro to implement methods related to Chase-Lev Work Stealing Deque using Stringification
+ * The owner thread pushes and pops at the back without locks, any number of thief threads steal from the front
+ * with a CAS on the front position. Memory orderings follow Le, Pop, Cohen and Zappa Nardelli,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ * Slots are atomic<t>, so t should be trivially copyable and small enough to be lock free (e.g. task pointers).
+ * When the ring is full the owner copies it into a buffer of double size. A thief may still be reading the old
+ * buffer, so old buffers are kept on a retired list and released only by the destructor.
+ */
+#define WorkStealingDeque_Custom(t)                                                                                                             \
+    using namespace std;                                                                                                                        \
+    /* Structure to represent ring buffer of Work Stealing Deque */                                                                             \
+    struct WorkStealingDeque_##t##_Buffer {                                                                                                     \
+        size_t list_capacity;                                                                                                                   \
+        size_t list_capacity_mask;                                                                                                              \
+        atomic<t> *t##_list;                                                                                                                    \
+        WorkStealingDeque_##t##_Buffer *retired_next;                                                                                           \
+    };                                                                                                                                          \
+    /* Structure to represent Work Stealing Deque */                                                                                            \
+    struct WorkStealingDeque_##t {                                                                                                              \
+        /* Variable declaration for Work Stealing Deque */                                                                                      \
+        char type_name[(sizeof "WorkStealingDeque_") + (sizeof #t) - 1];                                                                        \
+        WorkStealingDeque_##t##_Buffer *retired_buffers;                                                                                        \
+        /* Function Pointer declaration for Work Stealing Deque */                                                                              \
+        size_t (*size)(WorkStealingDeque_##t *deq);                                                                                             \
+        bool (*empty)(WorkStealingDeque_##t *deq);                                                                                              \
+        void (*push_back)(WorkStealingDeque_##t *deq, t);                                                                                       \
+        bool (*pop_back)(WorkStealingDeque_##t *deq, t *dst);                                                                                   \
+        bool (*steal_front)(WorkStealingDeque_##t *deq, t *dst);                                                                                \
+        void (*dtor)(WorkStealingDeque_##t *deq);                                                                                               \
+        /* Front position advanced by thieves (and by owner when taking the last element) */                                                    \
+        alignas(CACHE_LINE_SIZE) atomic<int64_t> list_front_position;                                                                           \
+        /* Back position and current buffer, written only by owner */                                                                           \
+        alignas(CACHE_LINE_SIZE) atomic<int64_t> list_back_position;                                                                            \
+        atomic<WorkStealingDeque_##t##_Buffer *> t##_buffer;                                                                                    \
+    };                                                                                                                                          \
+    /* Typedef for Work Stealing Deque structs */                                                                                               \
+    typedef struct WorkStealingDeque_##t##_Buffer WorkStealingDeque_##t##_Buffer;                                                               \
+    typedef struct WorkStealingDeque_##t WorkStealingDeque_##t;                                                                                 \
+    /* Function returns number of elements present in Work Stealing Deque (approximate while thieves are active) */                             \
+    inline size_t list_size(WorkStealingDeque_##t *deq) {                                                                                       \
+        int64_t front_position = deq->list_front_position.load(memory_order_acquire);                                                           \
+        int64_t back_position = deq->list_back_position.load(memory_order_acquire);                                                             \
+        return (back_position > front_position) ? (size_t) (back_position - front_position) : 0;                                                \
+    }                                                                                                                                           \
+    /* Function returns true if Work Stealing Deque is empty otherwise false */                                                                 \
+    inline bool list_empty(WorkStealingDeque_##t *deq) {                                                                                        \
+        return (list_size(deq) == 0);                                                                                                           \
+    }                                                                                                                                           \
+    /* Function returns new ring buffer with given capacity (power of two, deque selects the overload) */                                       \
+    inline WorkStealingDeque_##t##_Buffer *create_buffer_stealing(WorkStealingDeque_##t *, size_t capacity) {                                   \
+        auto *buffer = new WorkStealingDeque_##t##_Buffer;                                                                                      \
+        buffer->list_capacity = capacity;                                                                                                       \
+        buffer->list_capacity_mask = capacity - 1;                                                                                              \
+        buffer->t##_list = new atomic<t>[capacity];                                                                                             \
+        buffer->retired_next = nullptr;                                                                                                         \
+        return buffer;                                                                                                                          \
+    }                                                                                                                                           \
+    /* Function to double the ring buffer when it is full (owner only), the old buffer is retired */                                            \
+    inline WorkStealingDeque_##t##_Buffer *dynamic_buffer_stealing(WorkStealingDeque_##t *deq, WorkStealingDeque_##t##_Buffer *buffer,          \
+                                                                   int64_t front_position, int64_t back_position) {                             \
+        auto *new_buffer = create_buffer_stealing(deq, buffer->list_capacity * DOUBLE);                                                         \
+        for (int64_t position = front_position; position < back_position; position++) {                                                         \
+            t value = buffer->t##_list[position & buffer->list_capacity_mask].load(memory_order_relaxed);                                       \
+            new_buffer->t##_list[position & new_buffer->list_capacity_mask].store(value, memory_order_relaxed);                                 \
+        }                                                                                                                                       \
+        buffer->retired_next = deq->retired_buffers;                                                                                            \
+        deq->retired_buffers = buffer;                                                                                                          \
+        deq->t##_buffer.store(new_buffer, memory_order_release);                                                                                \
+        return new_buffer;                                                                                                                      \
+    }                                                                                                                                           \
+    /* Function to push new element to back side of Work Stealing Deque (owner only) */                                                         \
+    inline void push_back_stealing(WorkStealingDeque_##t *deq, t new_##t) {                                                                     \
+        int64_t back_position = deq->list_back_position.load(memory_order_relaxed);                                                             \
+        int64_t front_position = deq->list_front_position.load(memory_order_acquire);                                                           \
+        auto *buffer = deq->t##_buffer.load(memory_order_relaxed);                                                                              \
+        if (back_position - front_position > (int64_t) buffer->list_capacity - 1) {                                                             \
+            buffer = dynamic_buffer_stealing(deq, buffer, front_position, back_position);                                                       \
+        }                                                                                                                                       \
+        buffer->t##_list[back_position & buffer->list_capacity_mask].store(new_##t, memory_order_relaxed);                                      \
+        atomic_thread_fence(memory_order_release);                                                                                              \
+        deq->list_back_position.store(back_position + 1, memory_order_relaxed);                                                                 \
+    }                                                                                                                                           \
+    /* Function to pop element from back side of Work Stealing Deque into dst, returns false if it is empty (owner only) */                     \
+    inline bool pop_back_stealing(WorkStealingDeque_##t *deq, t *dst) {                                                                         \
+        int64_t back_position = deq->list_back_position.load(memory_order_relaxed) - 1;                                                         \
+        auto *buffer = deq->t##_buffer.load(memory_order_relaxed);                                                                              \
+        deq->list_back_position.store(back_position, memory_order_relaxed);                                                                     \
+        atomic_thread_fence(memory_order_seq_cst);                                                                                              \
+        int64_t front_position = deq->list_front_position.load(memory_order_relaxed);                                                           \
+        bool popped = true;                                                                                                                     \
+        if (front_position <= back_position) {                                                                                                  \
+            *dst = buffer->t##_list[back_position & buffer->list_capacity_mask].load(memory_order_relaxed);                                     \
+            if (front_position == back_position) {                                                                                              \
+                /* Last element, race with thieves for it */                                                                                    \
+                popped = deq->list_front_position.compare_exchange_strong(front_position, front_position + 1,                                   \
+                                                                            memory_order_seq_cst, memory_order_relaxed);                        \
+                deq->list_back_position.store(back_position + 1, memory_order_relaxed);                                                         \
+            }                                                                                                                                   \
+        } else {                                                                                                                                \
+            popped = false;                                                                                                                     \
+            deq->list_back_position.store(back_position + 1, memory_order_relaxed);                                                             \
+        }                                                                                                                                       \
+        return popped;                                                                                                                          \
+    }                                                                                                                                           \
+    /* Function to steal element from front side of Work Stealing Deque into dst */                                                             \
+    /* Returns false if it is empty or another thread took the element first (the caller may retry) */                                          \
+    inline bool steal_front_stealing(WorkStealingDeque_##t *deq, t *dst) {                                                                      \
+        int64_t front_position = deq->list_front_position.load(memory_order_acquire);                                                           \
+        atomic_thread_fence(memory_order_seq_cst);                                                                                              \
+        int64_t back_position = deq->list_back_position.load(memory_order_acquire);                                                             \
+        if (front_position >= back_position) {                                                                                                  \
+            return false;                                                                                                                       \
+        }                                                                                                                                       \
+        auto *buffer = deq->t##_buffer.load(memory_order_acquire);                                                                              \
+        t value = buffer->t##_list[front_position & buffer->list_capacity_mask].load(memory_order_relaxed);                                     \
+        if (!deq->list_front_position.compare_exchange_strong(front_position, front_position + 1,                                               \
+                                                              memory_order_seq_cst, memory_order_relaxed)) {                                    \
+            return false;                                                                                                                       \
+        }                                                                                                                                       \
+        *dst = value;                                                                                                                           \
+        return true;                                                                                                                            \
+    }                                                                                                                                           \
+    /* Function to deallocate all the heap memory allocations for Work Stealing Deque (no thread may use it anymore) */                         \
+    inline void dtor_stealing(WorkStealingDeque_##t *deq) {                                                                                     \
+        auto *buffer = deq->t##_buffer.load(memory_order_relaxed);                                                                              \
+        buffer->retired_next = deq->retired_buffers;                                                                                            \
+        while (buffer != nullptr) {                                                                                                             \
+            auto *next_buffer = buffer->retired_next;                                                                                           \
+            delete[] buffer->t##_list;                                                                                                          \
+            delete buffer;                                                                                                                      \
+            buffer = next_buffer;                                                                                                               \
+        }                                                                                                                                       \
+        deq->retired_buffers = nullptr;                                                                                                         \
+        deq->t##_buffer.store(nullptr, memory_order_relaxed);                                                                                   \
+    }                                                                                                                                           \
+    /* Direct-call API matching the one of Deque_Custom */                                                                                      \
+    inline size_t WorkStealingDeque_##t##_size(WorkStealingDeque_##t *deq) {                                                                    \
+        return list_size(deq);                                                                                                                  \
+    }                                                                                                                                           \
+    inline bool WorkStealingDeque_##t##_empty(WorkStealingDeque_##t *deq) {                                                                     \
+        return list_empty(deq);                                                                                                                 \
+    }                                                                                                                                           \
+    inline void WorkStealingDeque_##t##_push_back(WorkStealingDeque_##t *deq, t new_##t) {                                                      \
+        push_back_stealing(deq, new_##t);                                                                                                       \
+    }                                                                                                                                           \
+    inline bool WorkStealingDeque_##t##_pop_back(WorkStealingDeque_##t *deq, t *dst) {                                                          \
+        return pop_back_stealing(deq, dst);                                                                                                     \
+    }                                                                                                                                           \
+    inline bool WorkStealingDeque_##t##_steal_front(WorkStealingDeque_##t *deq, t *dst) {                                                       \
+        return steal_front_stealing(deq, dst);                                                                                                  \
+    }                                                                                                                                           \
+    inline void WorkStealingDeque_##t##_dtor(WorkStealingDeque_##t *deq) {                                                                      \
+        dtor_stealing(deq);                                                                                                                     \
+    }                                                                                                                                           \
+    /* Function to construct the Work Stealing Deque structure for the first time (must not be shared yet) */                                   \
+    inline void WorkStealingDeque_##t##_ctor(WorkStealingDeque_##t *deq) {                                                                      \
+        strcpy(deq->type_name, ("WorkStealingDeque_" #t));                                                                                      \
+        deq->retired_buffers = nullptr;                                                                                                         \
+        deq->list_front_position.store(0, memory_order_relaxed);                                                                                \
+        deq->list_back_position.store(0, memory_order_relaxed);                                                                                 \
+        deq->t##_buffer.store(create_buffer_stealing(deq, LIST_CAPACITY), memory_order_relaxed);                                                \
+        /* Initialization of function pointers */                                                                                               \
+        deq->size = list_size;                                                                                                                  \
+        deq->empty = list_empty;                                                                                                                \
+        deq->push_back = &push_back_stealing;                                                                                                   \
+        deq->pop_back = &pop_back_stealing;                                                                                                     \
+        deq->steal_front = &steal_front_stealing;                                                                                               \
+        deq->dtor = &dtor_stealing;                                                                                                             \
+    }
+
+#endif
@@ -0,0 +1,579 @@
+#ifndef NITESH_COMPACT_MAP_HPP
+#define NITESH_COMPACT_MAP_HPP
+
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <stdexcept>
+#include "map.hpp"
+
+#define COMPACT_MAX_LEVEL 31
+#define COMPACT_NIL 0xFFFFFFFFU
+#define COMPACT_HEAD 0xFFFFFFFEU
+#define COMPACT_FREE_LEVEL 0xFF
+#define COMPACT_BLOCK_SHIFT 12
+#define COMPACT_BLOCK_SIZE (1U << COMPACT_BLOCK_SHIFT)
+
+namespace nm {
+
+    /*
+     * Implementation of Compact Map class template (Skip List with 32-bit node indices)
+     * Nodes live in growable slabs and link to each other through 32-bit indices instead of raw pointers:
+     * - node records (tower offset, previous node, level) are kept in one vector
+     * - tower slots of all nodes are kept in one vector of 32-bit indices, freed towers are reused per level
+     * - value pairs are kept in fixed size blocks, so references to them stay valid while the map grows
+     * Supports up to 2^32 - 2 elements and bidirectional iterators
+    */
+    template<typename K, typename M>
+    class CompactMap {
+    public:
+        typedef std::pair<const K, M> ValueType;
+
+        CompactMap() : _num_of_elements{0}, _map_level{0}, _last_node{COMPACT_HEAD}, _free_node{COMPACT_NIL},
+                       _rand_level_gen{PROB_HALF, COMPACT_MAX_LEVEL} {
+            for (int i = 0; i <= COMPACT_MAX_LEVEL; ++i) {
+                _head_tower[i] = COMPACT_NIL;
+                _free_towers[i] = COMPACT_NIL;
+            }
+        }
+
+        // Copies slabs as they are, so the copy takes linear time and keeps tower heights of the source
+        CompactMap(const CompactMap &existing_map) : CompactMap() {
+            copy_from(existing_map);
+        }
+
+        CompactMap(std::initializer_list<ValueType> init_list) : CompactMap() {
+            insert(init_list.begin(), init_list.end());
+        }
+
+        CompactMap &operator=(const CompactMap &existing_map) {
+            // Handling self assignment of map objects
+            if (this != &existing_map) {
+                // Copy into a temporary map first, so this map stays untouched if copying an element throws
+                CompactMap copied_map(existing_map);
+                // Temporary map releases the current elements on destruction
+                swap_members(copied_map);
+            }
+            return *this;
+        }
+
+        ~CompactMap() {
+            clear();
+        }
+
+        /*
+         * Implementation of Nested Iterator class
+        */
+        class Iterator {
+        public:
+            Iterator() = delete; // Default ctor
+            Iterator(CompactMap *map, uint32_t index) : _map{map}, _index{index} {} // Parameter ctor
+
+            CompactMap *get_map() const {
+                return _map;
+            }
+
+            uint32_t get_index() const {
+                return _index;
+            }
+
+            // Returns a reference to the incremented iterator (preincrement)
+            Iterator &operator++() {
+                _index = _map->next_index(_index);
+                return *this;
+            }
+
+            // Returns an iterator pointing to the element prior to incrementing (postincrement)
+            Iterator operator++(int) {
+                Iterator temp_iter{*this};
+                _index = _map->next_index(_index);
+                return temp_iter;
+            }
+
+            // Returns a reference to the decremented iterator (predecrement)
+            Iterator &operator--() {
+                _index = _map->prev_index(_index);
+                return *this;
+            }
+
+            // Returns an iterator pointing to the element prior to decrementing (postdecrement)
+            Iterator operator--(int) {
+                Iterator temp_iter{*this};
+                _index = _map->prev_index(_index);
+                return temp_iter;
+            }
+
+            ValueType &operator*() const {
+                return _map->value(_index);
+            }
+
+            ValueType *operator->() const {
+                return &_map->value(_index);
+            }
+
+            friend bool operator==(const Iterator &iter_1, const Iterator &iter_2) {
+                return (iter_1._index == iter_2._index);
+            }
+
+            friend bool operator!=(const Iterator &iter_1, const Iterator &iter_2) {
+                return (iter_1._index != iter_2._index);
+            }
+
+        private:
+            CompactMap *_map;
+            uint32_t _index;
+        };
+
+        /*
+         * Implementation of Nested ConstIterator class
+        */
+        class ConstIterator {
+        public:
+            ConstIterator() = delete; // Default ctor
+            ConstIterator(const Iterator &iter) : _map{iter.get_map()}, _index{iter.get_index()} {} // Conversion ctor
+            ConstIterator(const CompactMap *map, uint32_t index) : _map{map}, _index{index} {} // Parameter ctor
+
+            uint32_t get_index() const {
+                return _index;
+            }
+
+            // Returns a reference to the incremented ConstIterator (preincrement)
+            ConstIterator &operator++() {
+                _index = _map->next_index(_index);
+                return *this;
+            }
+
+            // Returns an ConstIterator pointing to the element prior to incrementing (postincrement)
+            ConstIterator operator++(int) {
+                ConstIterator temp_iter{*this};
+                _index = _map->next_index(_index);
+                return temp_iter;
+            }
+
+            // Returns a reference to the decremented ConstIterator (predecrement)
+            ConstIterator &operator--() {
+                _index = _map->prev_index(_index);
+                return *this;
+            }
+
+            // Returns an ConstIterator pointing to the element prior to decrementing (postdecrement)
+            ConstIterator operator--(int) {
+                ConstIterator temp_iter{*this};
+                _index = _map->prev_index(_index);
+                return temp_iter;
+            }
+
+            const ValueType &operator*() const {
+                return _map->value(_index);
+            }
+
+            const ValueType *operator->() const {
+                return &_map->value(_index);
+            }
+
+            friend bool operator==(const ConstIterator &iter_1, const ConstIterator &iter_2) {
+                return (iter_1._index == iter_2._index);
+            }
+
+            friend bool operator!=(const ConstIterator &iter_1, const ConstIterator &iter_2) {
+                return (iter_1._index != iter_2._index);
+            }
+
+        private:
+            const CompactMap *_map;
+            uint32_t _index;
+        };
+
+        // Return number of elements in the map (size of Map)
+        size_t size() const {
+            return _num_of_elements;
+        }
+
+        // Returns true if the Map has no entries in it, false otherwise
+        bool empty() const {
+            return (_num_of_elements == 0);
+        }
+
+        // Returns an Iterator pointing to the first element, in order
+        Iterator begin() {
+            return Iterator{this, _head_tower[LOWEST_LEVEL]};
+        }
+
+        // Returns an Iterator pointing one past the last element, in order
+        Iterator end() {
+            return Iterator{this, COMPACT_NIL};
+        }
+
+        // Returns a ConstIterator pointing to the first element, in order
+        ConstIterator begin() const {
+            return ConstIterator{this, _head_tower[LOWEST_LEVEL]};
+        }
+
+        // Returns a ConstIterator pointing one past the last element, in order
+        ConstIterator end() const {
+            return ConstIterator{this, COMPACT_NIL};
+        }
+
+        // Returns an iterator to the given key (key is not found, return the end() iterator)
+        Iterator find(const K &find_key) {
+            return Iterator{this, find_index(find_key)};
+        }
+
+        // Returns an iterator to the given key (key is not found, return the end() iterator)
+        ConstIterator find(const K &find_key) const {
+            return ConstIterator{this, find_index(find_key)};
+        }
+
+        // Returns a reference to the mapped object at the specified key (key is not in the Map, throws std::out_of_range)
+        M &at(const K &find_key) {
+            uint32_t index = find_index(find_key);
+            if (index == COMPACT_NIL) {
+                throw std::out_of_range("Error ---> Key not found!!");
+            }
+            return value(index).second;
+        }
+
+        // Returns a const reference to the mapped object at the specified key (key is not in the map, throws std::out_of_range)
+        const M &at(const K &find_key) const {
+            uint32_t index = find_index(find_key);
+            if (index == COMPACT_NIL) {
+                throw std::out_of_range("Error ---> Key not found!!");
+            }
+            return value(index).second;
+        }
+
+        // If key is in the map, return a reference to the corresponding mapped object
+        // If not, value initialize a mapped object for that key and returns a reference to it
+        M &operator[](const K &find_key) {
+            return insert(std::make_pair(find_key, M())).first->second;
+        }
+
+        // Inserts the given pair into the map.
+        // If the key does not exist, returns an iterator pointing to the new element and true
+        // If the key exists, returns an iterator pointing to the element with the same key and false.
+        std::pair<Iterator, bool> insert(const ValueType &);
+
+        // Inserts range of objects into the map
+        template<typename IT_T>
+        void insert(IT_T range_beg, IT_T range_end) {
+            while (range_beg != range_end) {
+                insert(*range_beg);
+                ++range_beg;
+            }
+        }
+
+        // Removes the given object indicated by Iterator from the map
+        void erase(Iterator pos) {
+            if (pos.get_index() != COMPACT_NIL) {
+                erase(value(pos.get_index()).first);
+            }
+        }
+
+        // Removes the given object indicated by Key from the map
+        // Throws std::out_of_range if the key is not in the Map
+        void erase(const K &);
+
+        // Removes all elements from the map
+        void clear();
+
+        // Returns number of bytes used by the map (allocated slab capacity included)
+        MapMemoryUsage memory_usage() const;
+
+    private:
+        /*
+         * Node record, towers and values are stored in separate slabs
+        */
+        struct CompactNode {
+            uint32_t tower_offset;  // Offset of the first forward index in tower slab (next free node for free nodes)
+            uint32_t prev_node;     // Index of previous node (COMPACT_HEAD for the first node)
+            uint8_t level;          // Level of the node (COMPACT_FREE_LEVEL for free nodes)
+        };
+
+        ValueType &value(uint32_t index) const {
+            return _value_blocks[index >> COMPACT_BLOCK_SHIFT][index & (COMPACT_BLOCK_SIZE - 1)];
+        }
+
+        uint32_t *tower(uint32_t index) {
+            return (index == COMPACT_HEAD) ? _head_tower : &_towers[_nodes[index].tower_offset];
+        }
+
+        const uint32_t *tower(uint32_t index) const {
+            return (index == COMPACT_HEAD) ? _head_tower : &_towers[_nodes[index].tower_offset];
+        }
+
+        uint32_t next_index(uint32_t index) const {
+            return (index == COMPACT_NIL) ? COMPACT_NIL : _towers[_nodes[index].tower_offset];
+        }
+
+        // Decrementing end() gives the last element, like the tail node of Map
+        uint32_t prev_index(uint32_t index) const {
+            uint32_t prev = (index == COMPACT_NIL) ? _last_node : _nodes[index].prev_node;
+            return (prev == COMPACT_HEAD) ? COMPACT_NIL : prev;
+        }
+
+        // Descend through the towers, filling predecessors of the key at every level if requested
+        uint32_t find_predecessors(const K &find_key, uint32_t *updated_nodes) const {
+            uint32_t temp_node = COMPACT_HEAD;
+            for (int lvl = _map_level; lvl >= 0; --lvl) {
+                uint32_t next_node;
+                while ((next_node = tower(temp_node)[lvl]) != COMPACT_NIL && value(next_node).first < find_key) {
+                    temp_node = next_node;
+                }
+                if (updated_nodes != nullptr) {
+                    updated_nodes[lvl] = temp_node;
+                }
+            }
+            return tower(temp_node)[LOWEST_LEVEL];
+        }
+
+        uint32_t find_index(const K &find_key) const {
+            uint32_t index = find_predecessors(find_key, nullptr);
+            return (index != COMPACT_NIL && value(index).first == find_key) ? index : COMPACT_NIL;
+        }
+
+        // Take a node record and a tower of given level from the free lists or grow the slabs
+        uint32_t allocate_node(int level);
+
+        // Return node record and its tower to the free lists
+        void release_node(uint32_t index);
+
+        // Reproduce slabs of another map
+        void copy_from(const CompactMap &existing_map);
+
+        // Exchange all members with another map
+        void swap_members(CompactMap &other_map) {
+            std::swap(_num_of_elements, other_map._num_of_elements);
+            std::swap(_map_level, other_map._map_level);
+            std::swap(_last_node, other_map._last_node);
+            std::swap(_free_node, other_map._free_node);
+            std::swap(_head_tower, other_map._head_tower);
+            std::swap(_free_towers, other_map._free_towers);
+            _nodes.swap(other_map._nodes);
+            _towers.swap(other_map._towers);
+            _value_blocks.swap(other_map._value_blocks);
+            std::swap(_rand_level_gen, other_map._rand_level_gen);
+        }
+
+        size_t _num_of_elements;    // Represents number of elements in Map
+        int _map_level;             // Represents maximum node level present in the Map
+        uint32_t _last_node;        // Index of the last node (COMPACT_HEAD when empty)
+        uint32_t _free_node;        // Head of the free node list
+        uint32_t _head_tower[COMPACT_MAX_LEVEL + 1];
+        uint32_t _free_towers[COMPACT_MAX_LEVEL + 1];   // Free tower lists per level, linked through first slot
+        std::vector<CompactNode> _nodes;
+        std::vector<uint32_t> _towers;
+        std::vector<ValueType *> _value_blocks;
+        RandomLevelGenerator _rand_level_gen;
+    };
+
+    template<typename K, typename M>
+    uint32_t CompactMap<K, M>::allocate_node(int level) {
+        uint32_t index;
+        bool new_record = (_free_node == COMPACT_NIL);
+        if (!new_record) {
+            index = _free_node;
+            _free_node = _nodes[index].tower_offset;
+        } else {
+            if (_nodes.size() >= COMPACT_HEAD) {
+                throw std::length_error("Compact Map Error ---> Too many elements!!");
+            }
+            index = (uint32_t) _nodes.size();
+            _nodes.push_back(CompactNode{0, COMPACT_HEAD, COMPACT_FREE_LEVEL});
+            if ((index >> COMPACT_BLOCK_SHIFT) == _value_blocks.size()) {
+                _value_blocks.push_back(static_cast<ValueType *>(::operator new(COMPACT_BLOCK_SIZE * sizeof(ValueType))));
+            }
+        }
+
+        uint32_t offset = _free_towers[level];
+        if (offset != COMPACT_NIL) {
+            _free_towers[level] = _towers[offset];
+        } else {
+            try {
+                if (_towers.size() + level + 1 >= COMPACT_NIL) {
+                    throw std::length_error("Compact Map Error ---> Too many tower slots!!");
+                }
+                offset = (uint32_t) _towers.size();
+                _towers.resize(_towers.size() + level + 1);
+            } catch (...) {
+                // Give the node record back, its tower offset still links the free list
+                if (new_record) {
+                    _nodes.pop_back();
+                } else {
+                    _free_node = index;
+                }
+                throw;
+            }
+        }
+        for (int i = 0; i <= level; ++i) {
+            _towers[offset + i] = COMPACT_NIL;
+        }
+        _nodes[index].tower_offset = offset;
+        _nodes[index].level = (uint8_t) level;
+        return index;
+    }
+
+    template<typename K, typename M>
+    void CompactMap<K, M>::release_node(uint32_t index) {
+        CompactNode &node = _nodes[index];
+        _towers[node.tower_offset] = _free_towers[node.level];
+        _free_towers[node.level] = node.tower_offset;
+        node.level = COMPACT_FREE_LEVEL;
+        node.tower_offset = _free_node;
+        _free_node = index;
+    }
+
+    /*
+     * Function to implement insert a new pair into Compact Map
+     */
+    template<typename K, typename M>
+    std::pair<typename CompactMap<K, M>::Iterator, bool> CompactMap<K, M>::insert(const ValueType &new_pair) {
+        uint32_t updated_nodes[COMPACT_MAX_LEVEL + 1];
+        uint32_t temp_node = find_predecessors(new_pair.first, updated_nodes);
+
+        // Handling condition of duplicate keys
+        if (temp_node != COMPACT_NIL && value(temp_node).first == new_pair.first) {
+            return std::make_pair(Iterator{this, temp_node}, false);
+        }
+
+        int new_level = _rand_level_gen.generate_random_level();
+        for (int i = _map_level + 1; i <= new_level; ++i) {
+            updated_nodes[i] = COMPACT_HEAD;
+        }
+
+        // Slabs may grow here, so towers are looked up again afterwards
+        uint32_t new_node = allocate_node(new_level);
+        try {
+            new(&value(new_node)) ValueType(new_pair);
+        } catch (...) {
+            // Give the record back if copying the pair throws, the map itself is not modified yet
+            release_node(new_node);
+            throw;
+        }
+        if (new_level > _map_level) {
+            _map_level = new_level;
+        }
+        for (int i = 0; i <= new_level; ++i) {
+            uint32_t *prev_tower = tower(updated_nodes[i]);
+            _towers[_nodes[new_node].tower_offset + i] = prev_tower[i];
+            prev_tower[i] = new_node;
+        }
+
+        // Logic to manage previous index
+        _nodes[new_node].prev_node = updated_nodes[LOWEST_LEVEL];
+        uint32_t next_node = _towers[_nodes[new_node].tower_offset];
+        if (next_node != COMPACT_NIL) {
+            _nodes[next_node].prev_node = new_node;
+        } else {
+            _last_node = new_node;
+        }
+
+        ++_num_of_elements;
+        return std::make_pair(Iterator{this, new_node}, true);
+    }
+
+    /*
+     * Function to erase node with the specified Key from the Compact Map
+     * Otherwise throws exception std::out_of_range
+     */
+    template<typename K, typename M>
+    void CompactMap<K, M>::erase(const K &erase_key) {
+        uint32_t updated_nodes[COMPACT_MAX_LEVEL + 1];
+        uint32_t temp_node = find_predecessors(erase_key, updated_nodes);
+        if (temp_node == COMPACT_NIL || !(value(temp_node).first == erase_key)) {
+            throw std::out_of_range("Erase Error ---> Key not found!!");
+        }
+
+        // Redirect forward indices around the deleting node
+        const uint32_t *erase_tower = tower(temp_node);
+        for (int lvl = 0; lvl <= _nodes[temp_node].level; ++lvl) {
+            uint32_t *prev_tower = tower(updated_nodes[lvl]);
+            if (prev_tower[lvl] == temp_node) {
+                prev_tower[lvl] = erase_tower[lvl];
+            }
+        }
+        // Redirect backward index around the deleting node
+        if (erase_tower[LOWEST_LEVEL] == COMPACT_NIL) {
+            _last_node = _nodes[temp_node].prev_node;
+        } else {
+            _nodes[erase_tower[LOWEST_LEVEL]].prev_node = _nodes[temp_node].prev_node;
+        }
+
+        value(temp_node).~ValueType();
+        release_node(temp_node);
+        while (_map_level > 0 && _head_tower[_map_level] == COMPACT_NIL) {
+            --_map_level;
+        }
+        --_num_of_elements;
+    }
+
+    /*
+     * Function to clear all the elements of Compact Map and release the slabs
+     */
+    template<typename K, typename M>
+    void CompactMap<K, M>::clear() {
+        for (uint32_t index = _head_tower[LOWEST_LEVEL]; index != COMPACT_NIL; index = next_index(index)) {
+            value(index).~ValueType();
+        }
+        for (ValueType *block : _value_blocks) {
+            ::operator delete(block);
+        }
+        std::vector<CompactNode>().swap(_nodes);
+        std::vector<uint32_t>().swap(_towers);
+        std::vector<ValueType *>().swap(_value_blocks);
+        for (int i = 0; i <= COMPACT_MAX_LEVEL; ++i) {
+            _head_tower[i] = COMPACT_NIL;
+            _free_towers[i] = COMPACT_NIL;
+        }
+        _num_of_elements = 0;
+        _map_level = 0;
+        _last_node = COMPACT_HEAD;
+        _free_node = COMPACT_NIL;
+    }
+
+    template<typename K, typename M>
+    void CompactMap<K, M>::copy_from(const CompactMap &existing_map) {
+        _nodes = existing_map._nodes;
+        _towers = existing_map._towers;
+        for (size_t i = 0; i < existing_map._value_blocks.size(); ++i) {
+            _value_blocks.push_back(static_cast<ValueType *>(::operator new(COMPACT_BLOCK_SIZE * sizeof(ValueType))));
+        }
+        for (uint32_t index = existing_map._head_tower[LOWEST_LEVEL]; index != COMPACT_NIL;
+             index = existing_map.next_index(index)) {
+            try {
+                new(&value(index)) ValueType(existing_map.value(index));
+            } catch (...) {
+                // Destroy the pairs copied so far, head tower is still empty so clear() only releases the slabs
+                for (uint32_t copied = existing_map._head_tower[LOWEST_LEVEL]; copied != index;
+                     copied = existing_map.next_index(copied)) {
+                    value(copied).~ValueType();
+                }
+                clear();
+                throw;
+            }
+        }
+        for (int i = 0; i <= COMPACT_MAX_LEVEL; ++i) {
+            _head_tower[i] = existing_map._head_tower[i];
+            _free_towers[i] = existing_map._free_towers[i];
+        }
+        _num_of_elements = existing_map._num_of_elements;
+        _map_level = existing_map._map_level;
+        _last_node = existing_map._last_node;
+        _free_node = existing_map._free_node;
+    }
+
+    /*
+     * Function to report memory used by the Compact Map
+     */
+    template<typename K, typename M>
+    MapMemoryUsage CompactMap<K, M>::memory_usage() const {
+        MapMemoryUsage usage;
+        usage.node_bytes = _nodes.capacity() * sizeof(CompactNode);
+        usage.tower_bytes = _towers.capacity() * sizeof(uint32_t);
+        usage.value_bytes = _value_blocks.size() * COMPACT_BLOCK_SIZE * sizeof(ValueType);
+        usage.overhead_bytes = sizeof(CompactMap<K, M>) + _value_blocks.capacity() * sizeof(ValueType *);
+        usage.total_bytes = usage.node_bytes + usage.tower_bytes + usage.value_bytes + usage.overhead_bytes;
+        return usage;
+    }
+}
+
+#endif
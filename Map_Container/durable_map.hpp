@@ -0,0 +1,530 @@
+#ifndef NITESH_DURABLE_MAP_HPP
+#define NITESH_DURABLE_MAP_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <type_traits>
+#include <mutex>
+#include <condition_variable>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "map.hpp"
+
+#define WAL_FILE_NAME "/wal.log"
+#define SNAPSHOT_FILE_NAME "/snapshot.dat"
+#define SNAPSHOT_TEMP_FILE_NAME "/snapshot.tmp"
+#define SNAPSHOT_MAGIC "NMSNAP01"
+#define WAL_RECORD_HEADER 8
+#define WAL_OP_INSERT 1
+#define WAL_OP_ERASE 2
+#define DEFAULT_BATCH_BYTES (1 << 20)
+#define DEFAULT_CHECKPOINT_RECORDS 1000000
+
+namespace nm {
+
+    /*
+     * Encoding of keys and mapped objects in the log and snapshot files
+     * Trivially copyable types are stored as raw bytes, std::string as length followed by characters
+     * Overload durable_encode/durable_decode in namespace nm to store other types
+    */
+    template<typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    durable_encode(std::string &out, const T &value) {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value, bool>::type
+    durable_decode(const char *&cursor, const char *end, T &value) {
+        if ((size_t) (end - cursor) < sizeof(T)) {
+            return false;
+        }
+        memcpy(static_cast<void *>(&value), cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    inline void durable_encode(std::string &out, const std::string &value) {
+        uint32_t length = (uint32_t) value.size();
+        durable_encode(out, length);
+        out.append(value);
+    }
+
+    inline bool durable_decode(const char *&cursor, const char *end, std::string &value) {
+        uint32_t length = 0;
+        if (!durable_decode(cursor, end, length) || (size_t) (end - cursor) < length) {
+            return false;
+        }
+        value.assign(cursor, length);
+        cursor += length;
+        return true;
+    }
+
+    // FNV-1a checksum used to detect torn or corrupted records
+    inline uint32_t durable_checksum(const char *data, size_t length) {
+        uint32_t hash = 2166136261U;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= (unsigned char) data[i];
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    /*
+     * Implementation of Durable Map class template
+     * Every insert/erase is appended to a write-ahead log, log writes are grouped and made durable with one fsync
+     * per batch. The map is periodically checkpointed to a sorted snapshot file after which the log is truncated.
+     * On construction the last snapshot is loaded and the log is replayed on top of it.
+     * All member functions are thread safe.
+    */
+    template<typename K, typename M>
+    class DurableMap {
+    public:
+        typedef std::pair<const K, M> ValueType;
+
+        DurableMap() = delete; // Default ctor
+        DurableMap(const DurableMap &) = delete; // Copy ctor
+        DurableMap &operator=(const DurableMap &) = delete; // Assignment operator
+
+        // Opens (or creates) durable map stored in the given directory and recovers its state
+        // batch_bytes: pending log bytes after which a writer flushes the batch itself
+        // checkpoint_records: logged records after which a checkpoint is taken (0 disables automatic checkpoints)
+        DurableMap(const std::string &directory, size_t batch_bytes = DEFAULT_BATCH_BYTES,
+                   size_t checkpoint_records = DEFAULT_CHECKPOINT_RECORDS);
+
+        // Makes all logged operations durable and closes the log
+        ~DurableMap();
+
+        // Inserts the given pair and appends it to the log if the key was not present
+        // Returns true if the pair got inserted (durable after the next commit())
+        bool insert(const ValueType &);
+
+        // Removes the given key and appends the erase to the log
+        // Throws std::out_of_range if the key is not in the Map
+        void erase(const K &);
+
+        // Copies the mapped object of the key into value, returns false if key is not present
+        bool find(const K &, M &value) const;
+
+        // Return number of elements in the map
+        size_t size() const;
+
+        // Blocks until every operation issued before the call is durable (group commit)
+        void commit();
+
+        // Writes a snapshot of the whole map and truncates the log
+        void checkpoint();
+
+        // Returns the underlying map, callers must make sure no writer runs concurrently
+        const Map<K, M> &map() const {
+            return _map;
+        }
+
+    private:
+        // Encode one log record and add it to the pending batch
+        void append_record(unsigned char op, const K &key, const M *mapped);
+
+        // Write and fsync the pending batch, lock is released during I/O
+        // On failure the batch goes back in front of the pending records and the log is cut back to its old end
+        void flush_locked(std::unique_lock<std::mutex> &lock);
+
+        // Checkpoint while holding the lock
+        void checkpoint_locked(std::unique_lock<std::mutex> &lock);
+
+        // Load snapshot file into the map
+        void load_snapshot();
+
+        // Replay log records newer than the snapshot and cut off a torn tail
+        void replay_log();
+
+        // Read whole file into a string, returns false if it does not exist
+        static bool read_file(const std::string &path, std::string &contents);
+
+        // Write the whole buffer handling partial writes and EINTR
+        static void write_all(int fd, const char *data, size_t length);
+
+        // Throws std::runtime_error with errno description
+        static void throw_errno(const std::string &what) {
+            throw std::runtime_error("Durable Map Error ---> " + what + ": " + strerror(errno));
+        }
+
+        Map<K, M> _map;
+        std::string _directory;
+        int _wal_fd;
+        off_t _wal_size;                // Bytes of the log holding complete records
+        size_t _batch_bytes;
+        size_t _checkpoint_records;
+        size_t _records_since_checkpoint;
+        std::string _pending;           // Encoded records not yet written to the log
+        uint64_t _next_lsn;             // Log sequence number of the next record
+        uint64_t _durable_lsn;          // Last log sequence number known to be on disk
+        bool _flushing;                 // True while a thread writes a batch
+        bool _wal_failed;               // True if a torn batch could not be cut off the log (until next checkpoint)
+        mutable std::mutex _mutex;
+        std::condition_variable _flush_done;
+    };
+
+    /*
+     * Constructor recovers the map from snapshot and log
+     */
+    template<typename K, typename M>
+    DurableMap<K, M>::DurableMap(const std::string &directory, size_t batch_bytes, size_t checkpoint_records)
+            : _directory{directory}, _wal_fd{-1}, _wal_size{0}, _batch_bytes{batch_bytes},
+              _checkpoint_records{checkpoint_records}, _records_since_checkpoint{0}, _next_lsn{1}, _durable_lsn{0},
+              _flushing{false}, _wal_failed{false} {
+        if (mkdir(_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw_errno("mkdir " + _directory);
+        }
+        load_snapshot();
+        replay_log();
+        _wal_fd = open((_directory + WAL_FILE_NAME).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (_wal_fd < 0) {
+            throw_errno("open log");
+        }
+        _wal_size = lseek(_wal_fd, 0, SEEK_END);
+        if (_wal_size < 0) {
+            close(_wal_fd);
+            throw_errno("seek log");
+        }
+    }
+
+    /*
+     * Destructor flushes the pending batch
+     */
+    template<typename K, typename M>
+    DurableMap<K, M>::~DurableMap() {
+        try {
+            commit();
+        } catch (const std::exception &) {
+            // Nothing more can be done here, records after the last successful commit are lost
+        }
+        if (_wal_fd >= 0) {
+            close(_wal_fd);
+        }
+    }
+
+    /*
+     * Function to insert the pair into the map and log it
+     */
+    template<typename K, typename M>
+    bool DurableMap<K, M>::insert(const ValueType &new_pair) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_map.insert(new_pair).second) {
+            return false;
+        }
+        append_record(WAL_OP_INSERT, new_pair.first, &new_pair.second);
+        if (_checkpoint_records != 0 && _records_since_checkpoint >= _checkpoint_records) {
+            checkpoint_locked(lock);
+        } else if (_pending.size() >= _batch_bytes && !_flushing) {
+            flush_locked(lock);
+        }
+        return true;
+    }
+
+    /*
+     * Function to erase the key from the map and log it
+     */
+    template<typename K, typename M>
+    void DurableMap<K, M>::erase(const K &erase_key) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _map.erase(erase_key);
+        append_record(WAL_OP_ERASE, erase_key, nullptr);
+        if (_checkpoint_records != 0 && _records_since_checkpoint >= _checkpoint_records) {
+            checkpoint_locked(lock);
+        } else if (_pending.size() >= _batch_bytes && !_flushing) {
+            flush_locked(lock);
+        }
+    }
+
+    /*
+     * Function to look up the key
+     */
+    template<typename K, typename M>
+    bool DurableMap<K, M>::find(const K &find_key, M &value) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        typename Map<K, M>::ConstIterator iter = _map.find(find_key);
+        if (iter == _map.end()) {
+            return false;
+        }
+        value = iter->second;
+        return true;
+    }
+
+    template<typename K, typename M>
+    size_t DurableMap<K, M>::size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _map.size();
+    }
+
+    /*
+     * Function to wait until all operations issued so far are durable
+     * The first waiting thread becomes leader and writes everything pending, including records of other threads
+     */
+    template<typename K, typename M>
+    void DurableMap<K, M>::commit() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        uint64_t target_lsn = _next_lsn - 1;
+        while (_durable_lsn < target_lsn) {
+            if (_flushing) {
+                _flush_done.wait(lock);
+            } else {
+                flush_locked(lock);
+            }
+        }
+    }
+
+    template<typename K, typename M>
+    void DurableMap<K, M>::checkpoint() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        checkpoint_locked(lock);
+    }
+
+    /*
+     * Record layout: [payload length u32][checksum u32][lsn u64][op u8][key][mapped (insert only)]
+     */
+    template<typename K, typename M>
+    void DurableMap<K, M>::append_record(unsigned char op, const K &key, const M *mapped) {
+        size_t record_start = _pending.size();
+        _pending.append(WAL_RECORD_HEADER, '\0');
+        durable_encode(_pending, _next_lsn);
+        durable_encode(_pending, op);
+        durable_encode(_pending, key);
+        if (mapped != nullptr) {
+            durable_encode(_pending, *mapped);
+        }
+        uint32_t payload_length = (uint32_t) (_pending.size() - record_start - WAL_RECORD_HEADER);
+        uint32_t checksum = durable_checksum(_pending.data() + record_start + WAL_RECORD_HEADER, payload_length);
+        memcpy(&_pending[record_start], &payload_length, sizeof(payload_length));
+        memcpy(&_pending[record_start + sizeof(payload_length)], &checksum, sizeof(checksum));
+        ++_next_lsn;
+        ++_records_since_checkpoint;
+    }
+
+    /*
+     * Function to write pending batch and fsync it, other writers keep appending meanwhile
+     */
+    template<typename K, typename M>
+    void DurableMap<K, M>::flush_locked(std::unique_lock<std::mutex> &lock) {
+        if (_wal_failed) {
+            throw std::runtime_error("Durable Map Error ---> Log holds a torn batch, checkpoint to recover");
+        }
+        std::string batch;
+        batch.swap(_pending);
+        uint64_t batch_lsn = _next_lsn - 1;
+        off_t batch_offset = _wal_size;
+        _flushing = true;
+        lock.unlock();
+        try {
+            write_all(_wal_fd, batch.data(), batch.size());
+            if (fdatasync(_wal_fd) != 0) {
+                throw_errno("fdatasync log");
+            }
+        } catch (...) {
+            lock.lock();
+            // Cut off the part of the batch that reached the log, otherwise replay would stop at the torn record
+            // and drop every record appended after it. Records stay pending so that the next flush retries them.
+            if (ftruncate(_wal_fd, batch_offset) != 0) {
+                _wal_failed = true;
+            }
+            batch.append(_pending);
+            _pending.swap(batch);
+            _flushing = false;
+            _flush_done.notify_all();
+            throw;
+        }
+        lock.lock();
+        _wal_size = batch_offset + (off_t) batch.size();
+        if (batch_lsn > _durable_lsn) {
+            _durable_lsn = batch_lsn;
+        }
+        _flushing = false;
+        _flush_done.notify_all();
+    }
+
+    /*
+     * Snapshot layout: [magic][lsn u64][count u64] followed by sorted [key][mapped] entries and checksum u32
+     */
+    template<typename K, typename M>
+    void DurableMap<K, M>::checkpoint_locked(std::unique_lock<std::mutex> &lock) {
+        // Wait for a running batch so the log is not truncated under it
+        while (_flushing) {
+            _flush_done.wait(lock);
+        }
+        uint64_t snapshot_lsn = _next_lsn - 1;
+        std::string contents(SNAPSHOT_MAGIC);
+        durable_encode(contents, snapshot_lsn);
+        durable_encode(contents, (uint64_t) _map.size());
+        for (typename Map<K, M>::ConstIterator iter = _map.begin(); iter != _map.end(); ++iter) {
+            durable_encode(contents, iter->first);
+            durable_encode(contents, iter->second);
+        }
+        durable_encode(contents, durable_checksum(contents.data(), contents.size()));
+
+        // Write temporary file and atomically rename it over the previous snapshot
+        std::string temp_path = _directory + SNAPSHOT_TEMP_FILE_NAME;
+        int snapshot_fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (snapshot_fd < 0) {
+            throw_errno("open snapshot");
+        }
+        try {
+            write_all(snapshot_fd, contents.data(), contents.size());
+            if (fsync(snapshot_fd) != 0) {
+                throw_errno("fsync snapshot");
+            }
+        } catch (...) {
+            close(snapshot_fd);
+            throw;
+        }
+        close(snapshot_fd);
+        if (rename(temp_path.c_str(), (_directory + SNAPSHOT_FILE_NAME).c_str()) != 0) {
+            throw_errno("rename snapshot");
+        }
+        int dir_fd = open(_directory.c_str(), O_RDONLY);
+        if (dir_fd >= 0) {
+            fsync(dir_fd);
+            close(dir_fd);
+        }
+
+        // Snapshot covers every record, including the ones not yet written
+        _pending.clear();
+        if (ftruncate(_wal_fd, 0) != 0 || fdatasync(_wal_fd) != 0) {
+            throw_errno("truncate log");
+        }
+        _wal_size = 0;
+        _wal_failed = false;
+        _durable_lsn = snapshot_lsn;
+        _records_since_checkpoint = 0;
+        _flush_done.notify_all();
+    }
+
+    template<typename K, typename M>
+    void DurableMap<K, M>::load_snapshot() {
+        std::string contents;
+        if (!read_file(_directory + SNAPSHOT_FILE_NAME, contents)) {
+            return;
+        }
+        size_t magic_length = strlen(SNAPSHOT_MAGIC);
+        uint32_t checksum = 0;
+        if (contents.size() < magic_length + sizeof(checksum)
+            || contents.compare(0, magic_length, SNAPSHOT_MAGIC) != 0) {
+            throw std::runtime_error("Durable Map Error ---> Invalid snapshot file");
+        }
+        memcpy(&checksum, contents.data() + contents.size() - sizeof(checksum), sizeof(checksum));
+        if (checksum != durable_checksum(contents.data(), contents.size() - sizeof(checksum))) {
+            throw std::runtime_error("Durable Map Error ---> Snapshot checksum mismatch");
+        }
+
+        const char *cursor = contents.data() + magic_length;
+        const char *end = contents.data() + contents.size() - sizeof(checksum);
+        uint64_t snapshot_lsn = 0, count = 0;
+        if (!durable_decode(cursor, end, snapshot_lsn) || !durable_decode(cursor, end, count)) {
+            throw std::runtime_error("Durable Map Error ---> Truncated snapshot header");
+        }
+        for (uint64_t i = 0; i < count; ++i) {
+            K key;
+            M mapped;
+            if (!durable_decode(cursor, end, key) || !durable_decode(cursor, end, mapped)) {
+                throw std::runtime_error("Durable Map Error ---> Truncated snapshot entry");
+            }
+            _map.insert(std::make_pair(key, mapped));
+        }
+        _next_lsn = snapshot_lsn + 1;
+        _durable_lsn = snapshot_lsn;
+    }
+
+    template<typename K, typename M>
+    void DurableMap<K, M>::replay_log() {
+        std::string contents;
+        std::string wal_path = _directory + WAL_FILE_NAME;
+        if (!read_file(wal_path, contents)) {
+            return;
+        }
+        const char *data = contents.data();
+        size_t offset = 0;
+        while (contents.size() - offset >= WAL_RECORD_HEADER) {
+            uint32_t payload_length, checksum;
+            memcpy(&payload_length, data + offset, sizeof(payload_length));
+            memcpy(&checksum, data + offset + sizeof(payload_length), sizeof(checksum));
+            const char *cursor = data + offset + WAL_RECORD_HEADER;
+            if (contents.size() - offset - WAL_RECORD_HEADER < payload_length
+                || durable_checksum(cursor, payload_length) != checksum) {
+                break; // Torn write at the tail of the log
+            }
+            const char *end = cursor + payload_length;
+            uint64_t lsn = 0;
+            unsigned char op = 0;
+            K key;
+            if (!durable_decode(cursor, end, lsn) || !durable_decode(cursor, end, op)
+                || !durable_decode(cursor, end, key)) {
+                break;
+            }
+            // Records already covered by the snapshot are skipped
+            if (lsn >= _next_lsn) {
+                if (op == WAL_OP_INSERT) {
+                    M mapped;
+                    if (!durable_decode(cursor, end, mapped)) {
+                        break;
+                    }
+                    _map.insert(std::make_pair(key, mapped));
+                } else if (_map.find(key) != _map.end()) {
+                    _map.erase(key);
+                }
+                _next_lsn = lsn + 1;
+                ++_records_since_checkpoint;
+            }
+            offset += WAL_RECORD_HEADER + payload_length;
+        }
+        _durable_lsn = _next_lsn - 1;
+
+        // Drop the torn tail so that new records follow the last valid one
+        if (offset != contents.size() && truncate(wal_path.c_str(), (off_t) offset) != 0) {
+            throw_errno("truncate torn log tail");
+        }
+    }
+
+    template<typename K, typename M>
+    bool DurableMap<K, M>::read_file(const std::string &path, std::string &contents) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            if (errno == ENOENT) {
+                return false;
+            }
+            throw_errno("open " + path);
+        }
+        char buffer[1 << 16];
+        ssize_t bytes;
+        while ((bytes = read(fd, buffer, sizeof(buffer))) != 0) {
+            if (bytes < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                close(fd);
+                throw_errno("read " + path);
+            }
+            contents.append(buffer, (size_t) bytes);
+        }
+        close(fd);
+        return true;
+    }
+
+    template<typename K, typename M>
+    void DurableMap<K, M>::write_all(int fd, const char *data, size_t length) {
+        while (length > 0) {
+            ssize_t bytes = write(fd, data, length);
+            if (bytes < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno("write");
+            }
+            data += bytes;
+            length -= (size_t) bytes;
+        }
+    }
+}
+
+#endif
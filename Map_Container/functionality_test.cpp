@@ -1,5 +1,55 @@
 #include <cassert>
+#include <cstdio>
+#include <csignal>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <sys/resource.h>
 #include "map.hpp"
+#include "compact_map.hpp"
+#include "string_map.hpp"
+#include "priority_map.hpp"
+#include "durable_map.hpp"
+
+// Bytes attributed to maps through the allocation hook
+static std::ptrdiff_t hooked_bytes = 0;
+
+// Key type without std::hash support
+struct PlainKey {
+    int id;
+
+    bool operator<(const PlainKey &other) const { return id < other.id; }
+
+    bool operator==(const PlainKey &other) const { return id == other.id; }
+};
+
+// Mapped type whose copy throws once copies_left drops to zero, live counts constructed objects
+struct ThrowingCopy {
+    static int copies_left;
+    static int live;
+    int id;
+
+    explicit ThrowingCopy(int new_id) : id{new_id} { ++live; }
+
+    ThrowingCopy(const ThrowingCopy &other) : id{other.id} {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+
+    ~ThrowingCopy() { --live; }
+};
+
+int ThrowingCopy::copies_left = -1;
+int ThrowingCopy::live = 0;
+
+void count_map_bytes(const void *, std::ptrdiff_t bytes) {
+    hooked_bytes += bytes;
+}
 
 /*
  * Function to test new Map implementation
@@ -124,6 +174,604 @@ int main() {
     map8_1.insert({"PST", 'A'});
     assert(map8_1.size() == 1);
 
+    // Testing memory accounting and allocation hook
+    nm::set_map_allocation_hook(count_map_bytes);
+    {
+        nm::Map<int, double> map9_1;
+        nm::MapMemoryUsage usage9_1 = map9_1.memory_usage();
+        assert(usage9_1.node_bytes == 0 && usage9_1.tower_bytes == 0 && usage9_1.value_bytes == 0);
+        assert(hooked_bytes == (std::ptrdiff_t) (usage9_1.total_bytes - sizeof(map9_1)));
+        for (int i = 0; i < 1000; ++i) {
+            map9_1.insert({i, i * 0.5});
+        }
+        nm::MapMemoryUsage usage9_2 = map9_1.memory_usage();
+        assert(usage9_2.value_bytes == 1000 * sizeof(std::pair<const int, double>));
+        assert(usage9_2.tower_bytes >= 1000 * sizeof(void *));
+        assert(usage9_2.overhead_bytes == usage9_1.overhead_bytes);
+        assert(hooked_bytes == (std::ptrdiff_t) (usage9_2.total_bytes - sizeof(map9_1)));
+        nm::Map<int, double> map9_2{map9_1};
+        for (int i = 0; i < 500; ++i) {
+            map9_1.erase(i);
+        }
+        assert(hooked_bytes == (std::ptrdiff_t) (map9_1.memory_usage().total_bytes - sizeof(map9_1)
+                                                 + map9_2.memory_usage().total_bytes - sizeof(map9_2)));
+        map9_1.clear();
+        assert(map9_1.memory_usage().total_bytes == usage9_1.total_bytes);
+    }
+    assert(hooked_bytes == 0);
+    nm::set_map_allocation_hook(nullptr);
+
+    // Testing hot key cache
+    {
+        nm::Map<int, int> map10_1;
+        for (int i = 0; i < 1000; ++i) {
+            map10_1.insert({i, i * 2});
+        }
+        map10_1.enable_hot_cache(60);
+        assert(map10_1.hot_cache_capacity() == 64);
+        size_t usage10_1 = map10_1.memory_usage().total_bytes;
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 1000; i += (i < 10) ? 1 : 37) {
+                assert(map10_1.find(i)->second == i * 2);
+                assert(map10_1.at(i) == i * 2);
+            }
+        }
+        assert(map10_1.find(5000) == map10_1.end());
+        // Erased key must not be served from the cache
+        map10_1.erase(3);
+        assert(map10_1.find(3) == map10_1.end());
+        map10_1.erase(map10_1.find(4));
+        const nm::Map<int, int> &map10_2 = map10_1;
+        assert(map10_2.find(4) == map10_2.end());
+        assert(map10_2.at(5) == 10);
+        // Const lookups only read the cache, so they can run from several threads at once
+        {
+            std::vector<std::thread> readers;
+            for (int reader = 0; reader < 4; ++reader) {
+                readers.emplace_back([&map10_2]() {
+                    for (int round = 0; round < 100; ++round) {
+                        for (int i = 5; i < 1000; i += 7) {
+                            assert(map10_2.at(i) == i * 2 && map10_2.find(i)->second == i * 2);
+                        }
+                    }
+                });
+            }
+            for (std::thread &reader : readers) {
+                reader.join();
+            }
+        }
+        // Copies get a cache of the same size as the source
+        nm::Map<int, int> map10_4(map10_1);
+        assert(map10_4.hot_cache_capacity() == 64 && map10_4.at(5) == 10);
+        map10_4 = nm::Map<int, int>{{1, 1}};
+        assert(map10_4.hot_cache_capacity() == 0 && map10_4.at(1) == 1);
+        map10_4 = map10_1;
+        assert(map10_4.hot_cache_capacity() == 64 && map10_4 == map10_1);
+        map10_1.insert({3, 33});
+        assert(map10_1.at(3) == 33);
+        map10_1.clear();
+        assert(map10_1.hot_cache_capacity() == 64);
+        assert(map10_1.find(5) == map10_1.end());
+        assert(map10_1.memory_usage().total_bytes < usage10_1);
+        map10_1.disable_hot_cache();
+        assert(map10_1.hot_cache_capacity() == 0);
+
+        // Keys without std::hash keep working without the cache
+        nm::Map<PlainKey, int> map10_3{{{1}, 1}, {{2}, 2}};
+        map10_3.enable_hot_cache(16);
+        assert(map10_3.hot_cache_capacity() == 0);
+        assert(map10_3.at({2}) == 2);
+    }
+
+    // Testing durable map recovery from log and snapshot
+    {
+        char dir_template[] = "/tmp/nm_durable_XXXXXX";
+        std::string directory = mkdtemp(dir_template);
+        {
+            nm::DurableMap<int, std::string> map11_1(directory, 64, 0);
+            for (int i = 0; i < 100; ++i) {
+                assert(map11_1.insert({i, "value" + std::to_string(i)}));
+            }
+            assert(!map11_1.insert({5, "duplicate"}));
+            map11_1.erase(7);
+            try {
+                map11_1.erase(1000);
+                assert(false);
+            } catch (const std::out_of_range &) {
+            }
+            map11_1.commit();
+        }
+        {
+            // Replay of the log only
+            nm::DurableMap<int, std::string> map11_2(directory, 64, 0);
+            assert(map11_2.size() == 99);
+            std::string value;
+            assert(map11_2.find(5, value) && value == "value5");
+            assert(!map11_2.find(7, value));
+            map11_2.checkpoint();
+            map11_2.erase(8);
+            map11_2.insert({7, "again"});
+        }
+        {
+            // Snapshot plus log written after it, then a torn record at the tail
+            FILE *wal = fopen((directory + "/wal.log").c_str(), "ab");
+            fwrite("\x30\x00\x00\x00garbage", 1, 11, wal);
+            fclose(wal);
+            nm::DurableMap<int, std::string> map11_3(directory, 64, 0);
+            assert(map11_3.size() == 99);
+            std::string value;
+            assert(map11_3.find(7, value) && value == "again");
+            assert(!map11_3.find(8, value));
+            assert(map11_3.map().begin()->first == 0);
+            map11_3.insert({8, "after torn tail"});
+        }
+        {
+            // Group commit from several writers with automatic checkpoints
+            nm::DurableMap<int, std::string> map11_4(directory, 4096, 500);
+            std::string value;
+            assert(map11_4.find(8, value) && value == "after torn tail");
+            std::vector<std::thread> writers;
+            for (int t = 0; t < 4; ++t) {
+                writers.emplace_back([&map11_4, t]() {
+                    for (int i = 0; i < 300; ++i) {
+                        map11_4.insert({1000 + t * 1000 + i, "w"});
+                        if (i % 50 == 0) {
+                            map11_4.commit();
+                        }
+                    }
+                });
+            }
+            for (auto &writer : writers) {
+                writer.join();
+            }
+            assert(map11_4.size() == 100 + 1200);
+        }
+        {
+            nm::DurableMap<int, std::string> map11_5(directory);
+            assert(map11_5.size() == 1300);
+        }
+        {
+            // Failed batch write (file size limit hit in the middle of a record) is cut off the log and retried
+            std::string wal_path = directory + "/wal.log";
+            struct stat wal_stat;
+            nm::DurableMap<int, std::string> map11_6(directory, 1 << 20, 0);
+            assert(stat(wal_path.c_str(), &wal_stat) == 0);
+            off_t wal_size = wal_stat.st_size;
+            struct rlimit old_limit, new_limit;
+            getrlimit(RLIMIT_FSIZE, &old_limit);
+            new_limit = old_limit;
+            new_limit.rlim_cur = (rlim_t) wal_size + 100;
+            void (*old_handler)(int) = signal(SIGXFSZ, SIG_IGN);
+            setrlimit(RLIMIT_FSIZE, &new_limit);
+            for (int i = 0; i < 50; ++i) {
+                map11_6.insert({10000 + i, "pending"});
+            }
+            try {
+                map11_6.commit();
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            setrlimit(RLIMIT_FSIZE, &old_limit);
+            signal(SIGXFSZ, old_handler);
+            assert(stat(wal_path.c_str(), &wal_stat) == 0 && wal_stat.st_size == wal_size);
+            map11_6.insert({20000, "after failure"});
+            map11_6.commit();
+        }
+        {
+            nm::DurableMap<int, std::string> map11_7(directory);
+            assert(map11_7.size() == 1300 + 51);
+            std::string value;
+            assert(map11_7.find(10049, value) && value == "pending");
+            assert(map11_7.find(20000, value) && value == "after failure");
+        }
+        std::remove((directory + "/wal.log").c_str());
+        std::remove((directory + "/snapshot.dat").c_str());
+        std::remove(directory.c_str());
+    }
+
+    // Testing parallel comparison against sequential operators
+    {
+        nm::Map<int, int> map12_1, map12_2;
+        assert(map12_1 == map12_2 && nm::parallel_equal(map12_1, map12_2, 4));
+        for (int i = 0; i < 50000; ++i) {
+            map12_1.insert({i * 2, i});
+        }
+        map12_2 = map12_1;
+        assert(map12_1 == map12_2 && nm::parallel_equal(map12_1, map12_2, 4));
+        assert(!(map12_1 < map12_2) && !nm::parallel_less(map12_1, map12_2, 4));
+
+        // Different mapped value late in the map
+        map12_2[80000] = -1;
+        assert(map12_1 != map12_2 && !nm::parallel_equal(map12_1, map12_2, 4));
+        assert((map12_2 < map12_1) && nm::parallel_less(map12_2, map12_1, 4));
+        assert(!(map12_1 < map12_2) && !nm::parallel_less(map12_1, map12_2, 3));
+        map12_2[80000] = 40000;
+
+        // Extra key inside a range and missing last key
+        map12_2.insert({501, 0});
+        assert(!nm::parallel_equal(map12_1, map12_2, 4));
+        assert((map12_1 < map12_2) == nm::parallel_less(map12_1, map12_2, 4));
+        assert((map12_2 < map12_1) == nm::parallel_less(map12_2, map12_1, 4));
+        map12_2.erase(501);
+        map12_2.erase(99998);
+        assert(!nm::parallel_equal(map12_1, map12_2, 4));
+        assert(nm::parallel_less(map12_2, map12_1, 4) && !nm::parallel_less(map12_1, map12_2, 4));
+        assert((map12_2 < map12_1) && !(map12_1 < map12_2));
+    }
+
+    // Testing compact map against std::map with random inserts and erases
+    {
+        nm::CompactMap<int, std::string> map13_1;
+        std::map<int, std::string> reference13;
+        assert(map13_1.empty() && map13_1.begin() == map13_1.end());
+        srand(13);
+        for (int i = 0; i < 20000; ++i) {
+            int key = rand() % 5000;
+            if (rand() % 3 == 0 && reference13.count(key) != 0) {
+                map13_1.erase(key);
+                reference13.erase(key);
+            } else {
+                bool inserted = map13_1.insert({key, std::to_string(key)}).second;
+                assert(inserted == reference13.insert({key, std::to_string(key)}).second);
+            }
+        }
+        assert(map13_1.size() == reference13.size());
+        auto ref_iter13 = reference13.begin();
+        for (auto iter = map13_1.begin(); iter != map13_1.end(); ++iter, ++ref_iter13) {
+            assert(iter->first == ref_iter13->first && iter->second == ref_iter13->second);
+        }
+        // Backward iteration from end()
+        auto rev_iter13 = map13_1.end();
+        --rev_iter13;
+        assert(rev_iter13->first == reference13.rbegin()->first);
+        try {
+            map13_1.erase(-1);
+            assert(false);
+        } catch (const std::out_of_range &) {
+        }
+
+        // Copy keeps contents and stays independent
+        nm::CompactMap<int, std::string> map13_2{map13_1};
+        map13_2[-5] = "minus five";
+        assert(map13_2.size() == map13_1.size() + 1);
+        assert(map13_2.begin()->first == -5 && map13_1.find(-5) == map13_1.end());
+        const nm::CompactMap<int, std::string> &map13_3 = map13_2;
+        nm::CompactMap<int, std::string>::ConstIterator const_iter13 = map13_3.find(reference13.begin()->first);
+        assert(const_iter13->second == reference13.begin()->second);
+        map13_2.erase(map13_2.begin());
+        map13_2 = map13_1;
+        assert(map13_2.size() == map13_1.size());
+        assert(map13_2.at(reference13.begin()->first) == reference13.begin()->second);
+        map13_2.clear();
+        assert(map13_2.empty());
+
+        // Compact layout uses less memory than pointer based Map for the same contents
+        nm::Map<int, int> map13_4;
+        nm::CompactMap<int, int> map13_5;
+        for (int i = 0; i < 100000; ++i) {
+            map13_4.insert({i, i});
+            map13_5.insert({i, i});
+        }
+        assert(map13_5.memory_usage().total_bytes < map13_4.memory_usage().total_bytes);
+        assert(map13_5.memory_usage().tower_bytes < map13_4.memory_usage().tower_bytes);
+
+        // Copy failing inside insert gives the node record back, failing copy of the whole map leaves it empty
+        {
+            nm::CompactMap<int, ThrowingCopy> map13_6;
+            for (int i = 0; i < 3; ++i) {
+                assert(map13_6.insert({i, ThrowingCopy(i)}).first.get_index() == (uint32_t) i);
+            }
+            ThrowingCopy value13(3);
+            std::pair<const int, ThrowingCopy> pair13(3, value13);
+            ThrowingCopy::copies_left = 0;
+            try {
+                map13_6.insert(pair13);
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingCopy::copies_left = -1;
+            assert(map13_6.size() == 3 && map13_6.find(3) == map13_6.end());
+            assert(map13_6.insert({4, value13}).first.get_index() == 3);
+            ThrowingCopy::copies_left = 2;
+            try {
+                nm::CompactMap<int, ThrowingCopy> map13_7(map13_6);
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingCopy::copies_left = -1;
+            assert(ThrowingCopy::live == 4 + 2);
+
+            // Failing copy assignment leaves the target untouched
+            nm::CompactMap<int, ThrowingCopy> map13_8;
+            map13_8.insert({7, value13});
+            ThrowingCopy::copies_left = 2;
+            try {
+                map13_8 = map13_6;
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingCopy::copies_left = -1;
+            assert(map13_8.size() == 1 && map13_8.begin()->first == 7 && ThrowingCopy::live == 4 + 2 + 1);
+            map13_8 = map13_6;
+            assert(map13_8.size() == 4 && map13_8.find(7) == map13_8.end() && ThrowingCopy::live == 4 + 2 + 4);
+        }
+        assert(ThrowingCopy::live == 0);
+    }
+
+    // Testing prefix compressed string map against std::map with URL like keys
+    {
+        nm::StringMap<int> map14_1;
+        std::map<std::string, int> reference14;
+        const char *prefixes14[] = {"https://example.com/a/", "https://example.com/ab/", "https://example.org/", ""};
+        srand(14);
+        for (int i = 0; i < 20000; ++i) {
+            std::string key = std::string(prefixes14[rand() % 4]) + std::to_string(rand() % 3000);
+            if (rand() % 3 == 0 && reference14.count(key) != 0) {
+                map14_1.erase(key);
+                reference14.erase(key);
+            } else {
+                bool inserted = map14_1.insert({key, i}).second;
+                assert(inserted == reference14.insert({key, i}).second);
+            }
+        }
+        assert(map14_1.size() == reference14.size());
+        auto ref_iter14 = reference14.begin();
+        for (auto iter = map14_1.begin(); iter != map14_1.end(); ++iter, ++ref_iter14) {
+            assert(iter.key() == ref_iter14->first && iter.value() == ref_iter14->second);
+        }
+        for (const auto &element : reference14) {
+            assert(map14_1.find(element.first).key() == element.first);
+            assert(map14_1.at(element.first) == element.second);
+        }
+        assert(map14_1.find("https://example.com/a/") == map14_1.end());
+        assert(map14_1.find("https://example.com/a/99999") == map14_1.end());
+
+        // Backward iteration decodes keys from the closest full key
+        auto rev_iter14 = map14_1.end();
+        auto ref_rev_iter14 = reference14.rbegin();
+        for (int i = 0; i < 100; ++i, ++ref_rev_iter14) {
+            --rev_iter14;
+            assert(rev_iter14.key() == ref_rev_iter14->first);
+        }
+
+        // Const map only hands out read only access to mapped objects
+        const nm::StringMap<int> &map14_4 = map14_1;
+        static_assert(std::is_same<decltype(map14_4.at("")), const int &>::value, "const at() must not allow writes");
+        static_assert(std::is_same<decltype(map14_4.begin().value()), const int &>::value,
+                      "const iterators must not allow writes");
+        nm::StringMap<int>::ConstIterator const_iter14 = map14_4.find(reference14.begin()->first);
+        assert(const_iter14 == map14_1.begin() && const_iter14.value() == reference14.begin()->second);
+        size_t const_count14 = 0;
+        for (auto iter = map14_4.begin(); iter != map14_4.end(); ++iter) {
+            ++const_count14;
+        }
+        assert(const_count14 == reference14.size() && map14_4.find("missing") == map14_4.end());
+
+        nm::StringMap<int> map14_2{map14_1};
+        map14_2["https://example.net/"] = 7;
+        assert(map14_2.size() == map14_1.size() + 1 && map14_1.find("https://example.net/") == map14_1.end());
+        map14_2.erase(map14_2.begin());
+        map14_2 = map14_1;
+        assert(map14_2.size() == map14_1.size());
+        map14_2.clear();
+        assert(map14_2.empty() && map14_2.begin() == map14_2.end());
+
+        // Keys sharing long prefixes take less memory than full std::string copies
+        nm::Map<std::string, int> map14_3;
+        for (const auto &element : reference14) {
+            map14_3.insert(element);
+        }
+        assert(map14_1.memory_usage().total_bytes < map14_3.memory_usage().total_bytes);
+    }
+
+    // Testing range splitting and parallel iteration
+    {
+        nm::Map<int, long> map15_1;
+        for (int i = 0; i < 40000; ++i) {
+            map15_1.insert({i, 0});
+        }
+        std::vector<nm::MapRange<int, long>> ranges15 = map15_1.split_ranges(8);
+        assert(ranges15.size() > 1 && ranges15.size() <= 8);
+        assert(ranges15.front().begin() == map15_1.begin() && ranges15.back().end() == map15_1.end());
+        size_t count15 = 0;
+        for (size_t i = 0; i < ranges15.size(); ++i) {
+            assert(!ranges15[i].empty());
+            if (i > 0) {
+                assert(ranges15[i].begin() == ranges15[i - 1].end());
+            }
+            for (auto &element : ranges15[i]) {
+                (void) element;
+                ++count15;
+            }
+        }
+        assert(count15 == map15_1.size());
+        for (auto &element : map15_1.range()) {
+            assert(element.second == 0);
+        }
+
+        nm::parallel_for_each(map15_1, [](std::pair<const int, long> &element) {
+            element.second = element.first * 2L;
+        }, 4);
+        for (auto &element : map15_1) {
+            assert(element.second == element.first * 2L);
+        }
+        std::atomic<long> sum15{0};
+        nm::parallel_for_each(map15_1, [&sum15](std::pair<const int, long> &element) {
+            sum15 += element.second;
+        }, 3);
+        assert(sum15 == 2L * (39999L * 40000L / 2));
+        try {
+            nm::parallel_for_each(map15_1, [](std::pair<const int, long> &element) {
+                if (element.first == 30000) {
+                    throw std::runtime_error("stop");
+                }
+            }, 4);
+            assert(false);
+        } catch (const std::runtime_error &) {
+        }
+    }
+
+    // Testing priority queue operations
+    {
+        nm::Map<int, std::string> map16_1;
+        try {
+            map16_1.pop_front();
+            assert(false);
+        } catch (const std::out_of_range &) {
+        }
+        for (int i = 0; i < 1000; ++i) {
+            map16_1.insert({(i * 7) % 1000, std::to_string((i * 7) % 1000)});
+        }
+        map16_1.enable_hot_cache(16);
+        assert(map16_1.find(0) != map16_1.end());
+        assert(map16_1.pop_front().first == 0);
+        assert(map16_1.find(0) == map16_1.end());
+        assert(map16_1.pop_back().second == "999");
+        assert(map16_1.begin()->first == 1 && (--map16_1.end())->first == 998);
+        std::vector<std::pair<int, std::string>> extracted16;
+        assert(map16_1.extract_min(500, std::back_inserter(extracted16)) == 500);
+        for (int i = 0; i < 500; ++i) {
+            assert(extracted16[i].first == i + 1 && extracted16[i].second == std::to_string(i + 1));
+        }
+        assert(map16_1.size() == 498 && map16_1.begin()->first == 501);
+        assert(map16_1.find(501) == map16_1.begin() && map16_1.find(998) != map16_1.end());
+        assert(map16_1.rbegin()->first == 998);
+        map16_1.insert({0, "zero"});
+        assert(map16_1.begin()->first == 0);
+        extracted16.clear();
+        assert(map16_1.extract_min(10000, std::back_inserter(extracted16)) == 499);
+        assert(map16_1.empty() && map16_1.begin() == map16_1.end());
+        assert(map16_1.memory_usage().tower_bytes == 0);
+        map16_1.insert({5, "five"});
+        assert(map16_1.pop_back().first == 5 && map16_1.empty());
+
+        // Several producers with one consumer
+        nm::ConcurrentPriorityMap<int, int> queue16;
+        std::vector<std::thread> producers16;
+        for (int t = 0; t < 4; ++t) {
+            producers16.emplace_back([&queue16, t]() {
+                for (int i = 0; i < 2500; ++i) {
+                    queue16.push({i * 4 + t, t});
+                }
+            });
+        }
+        std::vector<std::pair<int, int>> drained16;
+        while (drained16.size() < 10000) {
+            queue16.extract_min(64, std::back_inserter(drained16));
+        }
+        for (auto &producer : producers16) {
+            producer.join();
+        }
+        std::pair<int, int> last16;
+        assert(!queue16.pop_front(last16) && queue16.size() == 0);
+        std::sort(drained16.begin(), drained16.end());
+        for (int i = 0; i < 10000; ++i) {
+            assert(drained16[i].first == i && drained16[i].second == i % 4);
+        }
+
+        // Equal keys are all kept and come out in push order
+        nm::ConcurrentPriorityMap<int, int> timers16;
+        for (int i = 0; i < 3; ++i) {
+            timers16.push({5, i});
+        }
+        timers16.push({3, 9});
+        drained16.clear();
+        assert(timers16.extract_min(2, std::back_inserter(drained16)) == 2 && timers16.size() == 2);
+        assert(timers16.pop_front(last16) && last16 == std::make_pair(5, 1));
+        assert(timers16.extract_min(10, std::back_inserter(drained16)) == 1 && timers16.size() == 0);
+        assert(drained16 == (std::vector<std::pair<int, int>>{{3, 9}, {5, 0}, {5, 2}}));
+
+        // A throwing write removes only the elements handed out before it
+        {
+            nm::Map<int, ThrowingCopy> map16_2;
+            for (int i = 0; i < 10; ++i) {
+                map16_2.insert({i, ThrowingCopy(i)});
+            }
+            std::vector<std::pair<const int, ThrowingCopy>> extracted16_2;
+            extracted16_2.reserve(10);
+            ThrowingCopy::copies_left = 3;
+            try {
+                map16_2.extract_min(10, std::back_inserter(extracted16_2));
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingCopy::copies_left = -1;
+            assert(extracted16_2.size() == 3 && extracted16_2[2].second.id == 2);
+            assert(map16_2.size() == 7 && map16_2.begin()->first == 3 && map16_2.find(2) == map16_2.end());
+            assert(ThrowingCopy::live == 10);
+            assert(map16_2.extract_min(10, std::back_inserter(extracted16_2)) == 7 && map16_2.empty());
+        }
+        assert(ThrowingCopy::live == 0);
+    }
+
+    // Testing structure preserving copy
+    {
+        nm::Map<int, std::string> map17_1;
+        nm::Map<int, std::string> map17_2(map17_1);
+        assert(map17_2.empty() && map17_2.begin() == map17_2.end());
+        for (int i = 0; i < 5000; ++i) {
+            map17_1.insert({(i * 37) % 5000, std::to_string(i)});
+        }
+        nm::Map<int, std::string> map17_3(map17_1);
+        assert(map17_3 == map17_1 && map17_3.size() == 5000);
+        assert(map17_3.memory_usage().total_bytes == map17_1.memory_usage().total_bytes);
+        assert(map17_3.rbegin()->first == 4999 && (--map17_3.end())->first == 4999);
+        for (int i = 0; i < 5000; i += 3) {
+            assert(map17_3.find(i) != map17_3.end() && map17_3[i] == map17_1[i]);
+            map17_3.erase(i);
+        }
+        for (int i = 5000; i < 5100; ++i) {
+            map17_3.insert({i, "new"});
+        }
+        assert(map17_1.size() == 5000 && map17_3.size() == 5000 - 1667 + 100);
+        map17_2.enable_hot_cache(8);
+        map17_3.enable_hot_cache(8);
+        map17_2 = map17_3;
+        assert(map17_2 == map17_3 && map17_2.hot_cache_capacity() == 8);
+        int expected17 = 0;
+        for (auto iter = map17_2.begin(); iter != map17_2.end(); ++iter) {
+            while (expected17 % 3 == 0 && expected17 < 5000) {
+                ++expected17;
+            }
+            assert(iter->first == expected17);
+            ++expected17;
+        }
+        map17_2 = nm::Map<int, std::string>();
+        assert(map17_2.empty() && map17_2.hot_cache_capacity() == 0);
+
+        // Copy failing part way leaves the assigned map untouched and releases every copied node
+        nm::set_map_allocation_hook(count_map_bytes);
+        {
+            nm::Map<int, ThrowingCopy> map17_4, map17_5;
+            for (int i = 0; i < 200; ++i) {
+                map17_4.insert({i, ThrowingCopy(i)});
+            }
+            for (int i = 0; i < 10; ++i) {
+                map17_5.insert({-i, ThrowingCopy(-i)});
+            }
+            std::ptrdiff_t hooked17 = hooked_bytes;
+            ThrowingCopy::copies_left = 100;
+            try {
+                map17_5 = map17_4;
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingCopy::copies_left = 100;
+            try {
+                nm::Map<int, ThrowingCopy> map17_6(map17_4);
+                assert(false);
+            } catch (const std::runtime_error &) {
+            }
+            ThrowingCopy::copies_left = -1;
+            assert(hooked_bytes == hooked17 && ThrowingCopy::live == 210);
+            assert(map17_5.size() == 10 && map17_5.begin()->first == -9 && (--map17_5.end())->first == 0);
+            map17_5 = map17_4;
+            assert(map17_5.size() == 200 && (--map17_5.end())->second.id == 199 && ThrowingCopy::live == 400);
+        }
+        assert(hooked_bytes == 0 && ThrowingCopy::live == 0);
+        nm::set_map_allocation_hook(nullptr);
+    }
+
     std::cout << "\nTest completed successfully !!\n" << std::endl;
 
     return 0;
@@ -6,16 +6,33 @@
 #include <cstdlib>
 #include <random>
 #include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <exception>
 
 #define MAX_NODE_LEVEL 100
 #define PROB_HALF 0.5
 #define LOWEST_LEVEL 0
+#define HOT_CACHE_PROBES 2
+#define HOT_CACHE_MAX_FREQ 3
+#define PARALLEL_MIN_ELEMENTS 16384
+#define PARALLEL_CHUNKS_PER_THREAD 4
+#define PARALLEL_ABORT_CHECK 1024
 
 // Macro used in constructor to initialize member variables
 #define MEMBER_INIT_CTOR                                                            \
     /* Initialization of size and max level */                                      \
     _num_of_elements = 0;                                                           \
     _map_level = 0;                                                                 \
+    _tower_slots = 0;                                                               \
+    _hot_cache = nullptr;                                                           \
+    _hot_cache_mask = 0;                                                            \
+    _hot_cache_shift = 0;                                                           \
     /* Memory allocation for new random level generator class object */             \
     _rand_level_gen = new RandomLevelGenerator(PROB_HALF, MAX_NODE_LEVEL);          \
     /* Memory allocation for head and tail nodes of Skip List */                    \
@@ -25,10 +42,13 @@
     _head_node->_fwd_nodes[LOWEST_LEVEL] = _tail_node;                              \
     _head_node->_prev_node = nullptr;                                               \
     _tail_node->_fwd_nodes[LOWEST_LEVEL] = nullptr;                                 \
-    _tail_node->_prev_node = _head_node;
+    _tail_node->_prev_node = _head_node;                                            \
+    /* Report head/tail towers and level generator to the allocation hook */        \
+    report_allocation(static_cast<std::ptrdiff_t>(fixed_heap_bytes()));
 
 // Macro used in destructor to deallocate heap memory
 #define DESTROY_ALLOCATIONS                                                         \
+    report_allocation(-static_cast<std::ptrdiff_t>(heap_bytes()));                  \
     SkipNode<K, M> *next_node = nullptr, *head_node = _head_node;                   \
     while (head_node != nullptr) {                                                  \
         next_node = head_node->_fwd_nodes[LOWEST_LEVEL];                            \
@@ -36,11 +56,48 @@
         head_node = nullptr;                                                        \
         head_node = next_node;                                                      \
     }                                                                               \
+    delete[] _hot_cache;                                                            \
     delete _rand_level_gen;
 
 
 namespace nm {
 
+    /*
+     * Global allocation hook used to attribute heap bytes to individual Map instances
+     * Called with the address of the Map and a positive (allocation) or negative (deallocation) byte delta
+    */
+    typedef void (*MapAllocationHook)(const void *map_instance, std::ptrdiff_t bytes);
+
+    inline MapAllocationHook &map_allocation_hook() {
+        static MapAllocationHook hook = nullptr;
+        return hook;
+    }
+
+    // Install (or remove by passing nullptr) the global allocation hook, not synchronized with running maps
+    inline void set_map_allocation_hook(MapAllocationHook hook) {
+        map_allocation_hook() = hook;
+    }
+
+    /*
+     * Trait to detect keys usable with std::hash (hot key cache is only available for them)
+    */
+    template<typename T, typename = void>
+    struct is_hashable : std::false_type {};
+
+    template<typename T>
+    struct is_hashable<T, decltype(void(std::hash<T>()(std::declval<const T &>())))> : std::true_type {};
+
+    /*
+     * Breakdown of the bytes used by a Map (malloc bookkeeping and heap memory owned by K and M are not included)
+    */
+    struct MapMemoryUsage {
+        size_t node_bytes;      // SkipNode objects of the elements
+        size_t tower_bytes;     // Forward pointer slots of the elements
+        size_t value_bytes;     // std::pair<const K, M> objects of the elements
+        size_t overhead_bytes;  // Map object, head/tail nodes with their towers, level generator and hot key cache
+        size_t total_bytes;     // Sum of all the above
+    };
+
     /*
      * Implementation of Random Level Generator class
      * Generate new random level according to provided Max Level and Probability
@@ -74,6 +131,10 @@ namespace nm {
     template<typename K, typename M>
     class Map;
 
+    // Forward declaration of Map Range class template
+    template<typename K, typename M>
+    class MapRange;
+
     /*
      * Implementation of Skip Node class template
      * Map support bidirectional iterators
@@ -103,8 +164,13 @@ namespace nm {
             for (int i = 0; i <= level; ++i) {
                 _fwd_nodes[i] = (SkipNode<K, M> *) nullptr;
             }
-            // Use copy constructor of std::pair<const K, M>
-            _value = new ValueType(value);
+            // Use copy constructor of std::pair<const K, M> (destructor does not run if it throws)
+            try {
+                _value = new ValueType(value);
+            } catch (...) {
+                delete[] _fwd_nodes;
+                throw;
+            }
         }
 
         ~SkipNode() {
@@ -112,6 +178,11 @@ namespace nm {
             delete _value;
         }
 
+        // Returns heap bytes held by the node (node object, forward pointer slots and value pair)
+        size_t memory_footprint() const {
+            return sizeof(SkipNode) + (_level_node + 1) * sizeof(SkipNode *) + (_value != nullptr ? sizeof(ValueType) : 0);
+        }
+
     private:
         ValueType *_value; // Mapped Type or mapped object to represent entire pair
         SkipNode **_fwd_nodes; // Link to forward nodes in the skip list
@@ -137,12 +208,15 @@ namespace nm {
             if (existing_map._head_node != nullptr) {
                 // Using macro to initialize private member variables (Create empty map)
                 MEMBER_INIT_CTOR
-                // Traverse through the existing map and insert element by element [Complexity of O(nlgn)] --- TO-DO in O(n)
-                SkipNode<K, M> *temp_node = existing_map._head_node->_fwd_nodes[LOWEST_LEVEL];
-                while (temp_node != existing_map._tail_node) {
-                    const ValueType &existing_value = *(temp_node->_value);
-                    insert(existing_value);
-                    temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
+                try {
+                    // Hot key cache is sized like the one of the existing map
+                    enable_hot_cache(existing_map.hot_cache_capacity());
+                    // Clone nodes of the existing map with their levels [Complexity of O(n)]
+                    clone_nodes(existing_map);
+                } catch (...) {
+                    // Destructor does not run for a throwing constructor, release the nodes copied so far
+                    DESTROY_ALLOCATIONS
+                    throw;
                 }
             }
         }
@@ -161,17 +235,10 @@ namespace nm {
         Map &operator=(const Map &existing_map) {
             // Handling self assignment of map objects
             if (this != &existing_map) {
-                // Using macro to destroy all memory allocations to clear current Map elements
-                DESTROY_ALLOCATIONS
-                // Using macro to initialize private member variables (Create empty map)
-                MEMBER_INIT_CTOR
-                // Traverse through the existing map and insert element by element
-                SkipNode<K, M> *temp_node = existing_map._head_node->_fwd_nodes[LOWEST_LEVEL];
-                while (temp_node != existing_map._tail_node) {
-                    const ValueType &existing_value = *(temp_node->_value);
-                    insert(existing_value);
-                    temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
-                }
+                // Copy into a temporary map first, so this map stays untouched if copying an element throws
+                Map copied_map(existing_map);
+                // Temporary map releases the current elements on destruction
+                swap_members(copied_map);
             }
             return *this;
         }
@@ -459,6 +526,38 @@ namespace nm {
         // Removes all elements from the map
         void clear();
 
+        // Removes the first element and returns it, unlinking it straight from the head tower
+        // Throws std::out_of_range if the Map is empty
+        ValueType pop_front();
+
+        // Removes the last element and returns it
+        // Throws std::out_of_range if the Map is empty
+        ValueType pop_back();
+
+        // Removes up to count smallest elements, writing them in order to out, returns number of removed elements
+        // All of them are cut off the head tower at once, costing O(count + levels)
+        // If a write to out throws, the elements written before it are removed and the rest stay in the Map
+        template<typename OUT_IT>
+        size_t extract_min(size_t count, OUT_IT out);
+
+        // Returns exact number of bytes used by the map, computed from counters in O(1)
+        MapMemoryUsage memory_usage() const;
+
+        // Enables the hot key cache with given number of slots (rounded up to power of two, 0 disables it)
+        // Point lookups through find() and at() are served from the cache for frequently hit keys
+        // Only available for keys supported by std::hash, only lookups on a non-const Map update the cache
+        // (const lookups just read it, so a const Map can be searched from several threads)
+        // A copy of the map gets a cache of the same size
+        void enable_hot_cache(size_t slots);
+
+        // Disables the hot key cache and releases its memory
+        void disable_hot_cache();
+
+        // Returns number of slots in the hot key cache (0 when disabled)
+        size_t hot_cache_capacity() const {
+            return (_hot_cache != nullptr) ? _hot_cache_mask + 1 : 0;
+        }
+
         // Compares the given maps for equality (Two maps compare equal if below satisfies)
         // If they have the same number of elements and if all elements compare equal
         template<typename Key_T, typename Mapped_T>
@@ -477,6 +576,22 @@ namespace nm {
         template<typename Key_T, typename Mapped_T>
         friend bool operator<(const Map<Key_T, Mapped_T> &, const Map<Key_T, Mapped_T> &);
 
+        // Returns the whole map as a range
+        MapRange<K, M> range();
+
+        // Cuts the map into at most given number of consecutive balanced ranges
+        // Split points are taken from the upper tower levels, so only a small part of the map is walked
+        std::vector<MapRange<K, M>> split_ranges(size_t parts);
+
+        // Parallel version of operator== using given number of threads (0 uses hardware concurrency)
+        // Both maps are cut into aligned key ranges at nodes of the upper tower levels, first mismatch stops all threads
+        template<typename Key_T, typename Mapped_T>
+        friend bool parallel_equal(const Map<Key_T, Mapped_T> &, const Map<Key_T, Mapped_T> &, unsigned);
+
+        // Parallel version of operator< using given number of threads (0 uses hardware concurrency)
+        template<typename Key_T, typename Mapped_T>
+        friend bool parallel_less(const Map<Key_T, Mapped_T> &, const Map<Key_T, Mapped_T> &, unsigned);
+
         // Friend functions to compare Iterators
         friend bool operator==(const Iterator &iter_1, const Iterator &iter_2) {
             return (iter_1.get_iter_ptr() == iter_2.get_iter_ptr());
@@ -519,11 +634,367 @@ namespace nm {
         }
 
     private:
+        /*
+         * Slot of the hot key cache (open addressing with short linear probing)
+        */
+        struct HotSlot {
+            SkipNode<K, M> *node;   // Cached node (nullptr if slot is empty)
+            size_t hash;            // Hash of the cached key
+            unsigned freq;          // Saturating hit counter used for replacement
+        };
+
+        // Hash of the key used by the hot key cache
+        size_t hot_key_hash(const K &key, std::true_type) const {
+            return std::hash<K>()(key);
+        }
+
+        size_t hot_key_hash(const K &, std::false_type) const {
+            return 0;
+        }
+
+        // First slot to probe for a given hash (multiplicative mixing of weak hashes like identity hash of ints)
+        size_t hot_slot_index(size_t hash) const {
+            return (size_t) (((uint64_t) hash * 0x9E3779B97F4A7C15ULL) >> _hot_cache_shift);
+        }
+
+        // Returns cache slot holding the key, otherwise nullptr
+        HotSlot *hot_cache_lookup(const K &key, size_t hash) const {
+            size_t index = hot_slot_index(hash);
+            for (int probe = 0; probe < HOT_CACHE_PROBES; ++probe) {
+                HotSlot &slot = _hot_cache[(index + probe) & _hot_cache_mask];
+                if (slot.node != nullptr && slot.hash == hash && slot.node->_value->first == key) {
+                    return &slot;
+                }
+            }
+            return nullptr;
+        }
+
+        // Admit node found by a full search, a busy slot is aged on every attempt and replaced once it is cold
+        void hot_cache_admit(SkipNode<K, M> *node, size_t hash) {
+            size_t index = hot_slot_index(hash);
+            HotSlot *victim = nullptr;
+            for (int probe = 0; probe < HOT_CACHE_PROBES; ++probe) {
+                HotSlot &slot = _hot_cache[(index + probe) & _hot_cache_mask];
+                if (slot.node == nullptr) {
+                    victim = &slot;
+                    break;
+                }
+                if (victim == nullptr || slot.freq < victim->freq) {
+                    victim = &slot;
+                }
+            }
+            if (victim->node == nullptr || victim->freq == 0) {
+                victim->node = node;
+                victim->hash = hash;
+                victim->freq = 0;
+            } else {
+                --victim->freq;
+            }
+        }
+
+        // Remove node from the hot key cache before it is deleted
+        void hot_cache_invalidate(SkipNode<K, M> *node) {
+            size_t hash = hot_key_hash(node->_value->first, is_hashable<K>());
+            size_t index = hot_slot_index(hash);
+            for (int probe = 0; probe < HOT_CACHE_PROBES; ++probe) {
+                HotSlot &slot = _hot_cache[(index + probe) & _hot_cache_mask];
+                if (slot.node == node) {
+                    slot.node = nullptr;
+                    slot.freq = 0;
+                }
+            }
+        }
+
+        // Returns node holding the key (reading but never updating the hot key cache), otherwise tail node
+        SkipNode<K, M> *find_node(const K &find_key) const {
+            if (_hot_cache != nullptr) {
+                HotSlot *slot = hot_cache_lookup(find_key, hot_key_hash(find_key, is_hashable<K>()));
+                if (slot != nullptr) {
+                    return slot->node;
+                }
+            }
+            return search_node(find_key);
+        }
+
+        // Returns node holding the key (counting hits and admitting keys into the hot key cache), otherwise tail node
+        SkipNode<K, M> *find_node_cached(const K &find_key) {
+            if (_hot_cache == nullptr) {
+                return search_node(find_key);
+            }
+            size_t hash = hot_key_hash(find_key, is_hashable<K>());
+            HotSlot *slot = hot_cache_lookup(find_key, hash);
+            if (slot != nullptr) {
+                if (slot->freq < HOT_CACHE_MAX_FREQ) {
+                    ++slot->freq;
+                }
+                return slot->node;
+            }
+            SkipNode<K, M> *found_node = search_node(find_key);
+            if (found_node != _tail_node) {
+                hot_cache_admit(found_node, hash);
+            }
+            return found_node;
+        }
+
+        // Returns node holding the key by searching the skip list, otherwise tail node
+        SkipNode<K, M> *search_node(const K &find_key) const {
+            SkipNode<K, M> *temp_node = _head_node;
+            // Traverse through the skip list to find the node with given key
+            for (int lvl = _map_level; lvl >= 0; --lvl) {
+                while (temp_node->_fwd_nodes[lvl] != nullptr && temp_node->_fwd_nodes[lvl]->_value != nullptr
+                       && temp_node->_fwd_nodes[lvl]->_value->first < find_key) {
+                    temp_node = temp_node->_fwd_nodes[lvl];
+                }
+            }
+            temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
+
+            if (temp_node->_value != nullptr && temp_node->_value->first == find_key) {
+                return temp_node;
+            }
+            return _tail_node;
+        }
+
+        // Returns first node with key not less than given key, otherwise tail node
+        SkipNode<K, M> *lower_bound_node(const K &find_key) const {
+            SkipNode<K, M> *temp_node = _head_node;
+            for (int lvl = _map_level; lvl >= 0; --lvl) {
+                while (temp_node->_fwd_nodes[lvl] != nullptr && temp_node->_fwd_nodes[lvl]->_value != nullptr
+                       && temp_node->_fwd_nodes[lvl]->_value->first < find_key) {
+                    temp_node = temp_node->_fwd_nodes[lvl];
+                }
+            }
+            return temp_node->_fwd_nodes[LOWEST_LEVEL];
+        }
+
+        // Collect up to (parts - 1) evenly spaced nodes splitting the map into parts
+        // Nodes are taken from the highest tower level having enough of them, so only a small part of the list is walked
+        // (upper level lists end with nullptr, only the lowest level ends at the tail node)
+        void split_nodes(size_t parts, std::vector<SkipNode<K, M> *> &splits) const {
+            splits.clear();
+            if (parts <= 1 || _num_of_elements < parts) {
+                return;
+            }
+            int lvl = _map_level;
+            size_t count = 0;
+            for (; lvl > LOWEST_LEVEL; --lvl) {
+                count = 0;
+                for (SkipNode<K, M> *node = _head_node->_fwd_nodes[lvl];
+                     node != nullptr && node != _tail_node; node = node->_fwd_nodes[lvl]) {
+                    ++count;
+                }
+                if (count >= parts) {
+                    break;
+                }
+            }
+            if (lvl == LOWEST_LEVEL) {
+                count = _num_of_elements;
+            }
+            size_t step = count / parts, index = 0;
+            for (SkipNode<K, M> *node = _head_node->_fwd_nodes[lvl];
+                 node != nullptr && node != _tail_node && splits.size() < parts - 1; node = node->_fwd_nodes[lvl]) {
+                if (index != 0 && index % step == 0) {
+                    splits.push_back(node);
+                }
+                ++index;
+            }
+        }
+
+        // Compare elements of both maps lying before end_key (whole remainder if nullptr)
+        // Returns -1, 0 or 1 in lexicographic order, or 0/1 for equality only (ordered false)
+        // Gives up returning 0 once an earlier chunk than own has found a mismatch
+        static int compare_range(const SkipNode<K, M> *node_1, const SkipNode<K, M> *tail_1,
+                                 const SkipNode<K, M> *node_2, const SkipNode<K, M> *tail_2, const K *end_key,
+                                 bool ordered, size_t chunk, const std::atomic<size_t> &first_mismatch) {
+            for (size_t steps = 1;; ++steps) {
+                bool in_range_1 = (node_1 != tail_1 && (end_key == nullptr || node_1->_value->first < *end_key));
+                bool in_range_2 = (node_2 != tail_2 && (end_key == nullptr || node_2->_value->first < *end_key));
+                if (!in_range_1 && !in_range_2) {
+                    return 0;
+                }
+                // One map leaves the range first: it is either exhausted (shorter) or continues with a greater key
+                if (!in_range_1) {
+                    return (!ordered || node_1 != tail_1) ? 1 : -1;
+                }
+                if (!in_range_2) {
+                    return (!ordered || node_2 == tail_2) ? 1 : -1;
+                }
+                if (!ordered) {
+                    if (*node_1->_value != *node_2->_value) {
+                        return 1;
+                    }
+                } else if (*node_1->_value < *node_2->_value) {
+                    return -1;
+                } else if (*node_2->_value < *node_1->_value) {
+                    return 1;
+                }
+                node_1 = node_1->_fwd_nodes[LOWEST_LEVEL];
+                node_2 = node_2->_fwd_nodes[LOWEST_LEVEL];
+                if (steps % PARALLEL_ABORT_CHECK == 0 && first_mismatch.load(std::memory_order_relaxed) < chunk) {
+                    return 0;
+                }
+            }
+        }
+
+        // Compare both maps on several threads, result as in compare_range
+        static int parallel_compare(const Map &map_1, const Map &map_2, unsigned threads, bool ordered) {
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            std::vector<SkipNode<K, M> *> splits;
+            if (threads > 1 && map_1._num_of_elements >= PARALLEL_MIN_ELEMENTS) {
+                map_1.split_nodes((size_t) threads * PARALLEL_CHUNKS_PER_THREAD, splits);
+            }
+            size_t chunks = splits.size() + 1;
+            std::atomic<size_t> first_mismatch{chunks};
+            if (chunks == 1) {
+                return compare_range(map_1._head_node->_fwd_nodes[LOWEST_LEVEL], map_1._tail_node,
+                                     map_2._head_node->_fwd_nodes[LOWEST_LEVEL], map_2._tail_node, nullptr,
+                                     ordered, 0, first_mismatch);
+            }
+
+            // Chunk i covers keys from splits[i - 1] (inclusive) to splits[i] (exclusive) in both maps
+            std::vector<int> results(chunks, 0);
+            std::atomic<size_t> next_chunk{0};
+            auto worker = [&]() {
+                size_t chunk;
+                while ((chunk = next_chunk.fetch_add(1)) < chunks && chunk <= first_mismatch.load()) {
+                    const SkipNode<K, M> *start_1, *start_2;
+                    if (chunk == 0) {
+                        start_1 = map_1._head_node->_fwd_nodes[LOWEST_LEVEL];
+                        start_2 = map_2._head_node->_fwd_nodes[LOWEST_LEVEL];
+                    } else {
+                        start_1 = splits[chunk - 1];
+                        start_2 = map_2.lower_bound_node(splits[chunk - 1]->_value->first);
+                    }
+                    const K *end_key = (chunk + 1 < chunks) ? &splits[chunk]->_value->first : nullptr;
+                    int result = compare_range(start_1, map_1._tail_node, start_2, map_2._tail_node, end_key,
+                                               ordered, chunk, first_mismatch);
+                    if (result != 0) {
+                        results[chunk] = result;
+                        size_t current = first_mismatch.load();
+                        while (chunk < current && !first_mismatch.compare_exchange_weak(current, chunk)) {
+                        }
+                    }
+                }
+            };
+            std::vector<std::thread> workers;
+            for (unsigned i = 1; i < threads; ++i) {
+                workers.emplace_back(worker);
+            }
+            worker();
+            for (auto &thread : workers) {
+                thread.join();
+            }
+            size_t mismatch = first_mismatch.load();
+            return (mismatch < chunks) ? results[mismatch] : 0;
+        }
+
+        /*
+         * Append copies of all nodes of the existing map to this empty map in a single pass
+         * Each copy keeps the level of its source node, so no random levels are drawn and no searches are done
+         * last_nodes[lvl] holds the most recent node linked on level lvl
+        */
+        void clone_nodes(const Map &existing_map) {
+            SkipNode<K, M> *last_nodes[MAX_NODE_LEVEL + 1];
+            for (int lvl = 0; lvl <= existing_map._map_level; ++lvl) {
+                last_nodes[lvl] = _head_node;
+            }
+
+            SkipNode<K, M> *existing_node = existing_map._head_node->_fwd_nodes[LOWEST_LEVEL];
+            try {
+                while (existing_node != existing_map._tail_node) {
+                    SkipNode<K, M> *new_node = create_node(existing_node->_level_node, *(existing_node->_value));
+                    new_node->_prev_node = last_nodes[LOWEST_LEVEL];
+                    for (int lvl = 0; lvl <= new_node->_level_node; ++lvl) {
+                        last_nodes[lvl]->_fwd_nodes[lvl] = new_node;
+                        last_nodes[lvl] = new_node;
+                    }
+                    if (new_node->_level_node > _map_level) {
+                        _map_level = new_node->_level_node;
+                    }
+                    ++_num_of_elements;
+                    existing_node = existing_node->_fwd_nodes[LOWEST_LEVEL];
+                }
+            } catch (...) {
+                // Terminate the nodes copied so far, so that the map is valid and can be released by the caller
+                last_nodes[LOWEST_LEVEL]->_fwd_nodes[LOWEST_LEVEL] = _tail_node;
+                _tail_node->_prev_node = last_nodes[LOWEST_LEVEL];
+                throw;
+            }
+
+            // Only the lowest level ends at tail node, upper levels keep their nullptr terminators
+            last_nodes[LOWEST_LEVEL]->_fwd_nodes[LOWEST_LEVEL] = _tail_node;
+            _tail_node->_prev_node = last_nodes[LOWEST_LEVEL];
+        }
+
+        // Exchange contents (nodes, level generator and hot key cache) with the other map
+        // Heap bytes are reported to the allocation hook under the map that owns them afterwards
+        void swap_members(Map &other_map) {
+            std::ptrdiff_t bytes = static_cast<std::ptrdiff_t>(heap_bytes());
+            std::ptrdiff_t other_bytes = static_cast<std::ptrdiff_t>(other_map.heap_bytes());
+            report_allocation(other_bytes - bytes);
+            other_map.report_allocation(bytes - other_bytes);
+            std::swap(_num_of_elements, other_map._num_of_elements);
+            std::swap(_tower_slots, other_map._tower_slots);
+            std::swap(_map_level, other_map._map_level);
+            std::swap(_head_node, other_map._head_node);
+            std::swap(_tail_node, other_map._tail_node);
+            std::swap(_rand_level_gen, other_map._rand_level_gen);
+            std::swap(_hot_cache, other_map._hot_cache);
+            std::swap(_hot_cache_mask, other_map._hot_cache_mask);
+            std::swap(_hot_cache_shift, other_map._hot_cache_shift);
+        }
+
+        // Remove the count first nodes, cut_node is the first node which stays in the Map
+        void unlink_front(SkipNode<K, M> *cut_node, size_t count);
+
+        // Allocate a new element node and account its memory
+        SkipNode<K, M> *create_node(int level, const ValueType &value) {
+            SkipNode<K, M> *new_node = new SkipNode<K, M>(level, value);
+            _tower_slots += level + 1;
+            report_allocation(static_cast<std::ptrdiff_t>(new_node->memory_footprint()));
+            return new_node;
+        }
+
+        // Release an element node and account its memory
+        void destroy_node(SkipNode<K, M> *node) {
+            if (_hot_cache != nullptr) {
+                hot_cache_invalidate(node);
+            }
+            _tower_slots -= node->_level_node + 1;
+            report_allocation(-static_cast<std::ptrdiff_t>(node->memory_footprint()));
+            delete node;
+        }
+
+        // Heap bytes held by head/tail nodes with full towers and the level generator
+        static size_t fixed_heap_bytes() {
+            return 2 * (sizeof(SkipNode<K, M>) + (MAX_NODE_LEVEL + 1) * sizeof(SkipNode<K, M> *))
+                   + sizeof(RandomLevelGenerator);
+        }
+
+        // Heap bytes currently held by the map
+        size_t heap_bytes() const {
+            return fixed_heap_bytes() + hot_cache_capacity() * sizeof(HotSlot) + _num_of_elements * (sizeof(SkipNode<K, M>) + sizeof(ValueType))
+                   + _tower_slots * sizeof(SkipNode<K, M> *);
+        }
+
+        // Forward allocation delta to the global hook if one is installed
+        void report_allocation(std::ptrdiff_t bytes) const {
+            MapAllocationHook hook = map_allocation_hook();
+            if (hook != nullptr) {
+                hook(this, bytes);
+            }
+        }
+
         size_t _num_of_elements;    // Represents number of elements in Map
+        size_t _tower_slots;   // Represents number of forward pointer slots held by element nodes
         int _map_level;        // Represents maximum node level present in the Map
         SkipNode<K, M> *_head_node;
         SkipNode<K, M> *_tail_node;
         RandomLevelGenerator *_rand_level_gen;
+        HotSlot *_hot_cache;            // Hot key cache (nullptr if disabled)
+        size_t _hot_cache_mask;         // Number of cache slots minus one
+        int _hot_cache_shift;           // Shift selecting top bits of the mixed hash
     };
 
     /*
@@ -532,25 +1003,7 @@ namespace nm {
      */
     template<typename K, typename M>
     typename Map<K, M>::Iterator Map<K, M>::find(const K &find_key) {
-
-        // Variable declarations and definitions
-        SkipNode<K, M> *ret_node, *temp_node = _head_node;
-
-        // Traverse through the skip list to find the correct location to insert the new pair
-        for (int lvl = _map_level; lvl >= 0; --lvl) {
-            while (temp_node->_fwd_nodes[lvl] != nullptr && temp_node->_fwd_nodes[lvl]->_value != nullptr
-                   && temp_node->_fwd_nodes[lvl]->_value->first < find_key) {
-                temp_node = temp_node->_fwd_nodes[lvl];
-            }
-        }
-        temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
-
-        if (temp_node->_value != nullptr && temp_node->_value->first == find_key) {
-            ret_node = temp_node;
-        } else {
-            ret_node = _tail_node;
-        }
-        return Map<K, M>::Iterator(ret_node);
+        return Map<K, M>::Iterator(find_node_cached(find_key));
     }
 
     /*
@@ -559,25 +1012,7 @@ namespace nm {
      */
     template<typename K, typename M>
     typename Map<K, M>::ConstIterator Map<K, M>::find(const K &find_key) const {
-
-        // Variable declarations and definitions
-        SkipNode<K, M> *ret_node, *temp_node = _head_node;
-
-        // Traverse through the skip list to find the correct location to insert the new pair
-        for (int lvl = _map_level; lvl >= 0; --lvl) {
-            while (temp_node->_fwd_nodes[lvl] != nullptr && temp_node->_fwd_nodes[lvl]->_value != nullptr
-                   && temp_node->_fwd_nodes[lvl]->_value->first < find_key) {
-                temp_node = temp_node->_fwd_nodes[lvl];
-            }
-        }
-        temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
-
-        if (temp_node->_value != nullptr && temp_node->_value->first == find_key) {
-            ret_node = temp_node;
-        } else {
-            ret_node = _tail_node;
-        }
-        return Map<K, M>::ConstIterator(ret_node);
+        return Map<K, M>::ConstIterator(find_node(find_key));
     }
 
     /*
@@ -586,24 +1021,11 @@ namespace nm {
      */
     template<typename K, typename M>
     M &Map<K, M>::at(const K &find_key) {
-
-        // Variable declarations and definitions
-        SkipNode<K, M> *temp_node = _head_node;
-
-        // Traverse through the skip list to find the correct location to insert the new pair
-        for (int lvl = _map_level; lvl >= 0; --lvl) {
-            while (temp_node->_fwd_nodes[lvl] != nullptr && temp_node->_fwd_nodes[lvl]->_value != nullptr
-                   && temp_node->_fwd_nodes[lvl]->_value->first < find_key) {
-                temp_node = temp_node->_fwd_nodes[lvl];
-            }
-        }
-        temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
-
-        if (temp_node->_value != nullptr && temp_node->_value->first == find_key) {
-            return temp_node->_value->second;
-        } else {
+        SkipNode<K, M> *found_node = find_node_cached(find_key);
+        if (found_node == _tail_node) {
             throw std::out_of_range("Error ---> Key not found!!");
         }
+        return found_node->_value->second;
     }
 
     /*
@@ -612,23 +1034,11 @@ namespace nm {
      */
     template<typename K, typename M>
     const M &Map<K, M>::at(const K &find_key) const {
-        // Variable declarations and definitions
-        SkipNode<K, M> *temp_node = _head_node;
-
-        // Traverse through the skip list to find the correct location to insert the new pair
-        for (int lvl = _map_level; lvl >= 0; --lvl) {
-            while (temp_node->_fwd_nodes[lvl] != nullptr && temp_node->_fwd_nodes[lvl]->_value != nullptr
-                   && temp_node->_fwd_nodes[lvl]->_value->first < find_key) {
-                temp_node = temp_node->_fwd_nodes[lvl];
-            }
-        }
-        temp_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
-
-        if (temp_node->_value != nullptr && temp_node->_value->first == find_key) {
-            return temp_node->_value->second;
-        } else {
+        SkipNode<K, M> *found_node = find_node(find_key);
+        if (found_node == _tail_node) {
             throw std::out_of_range("Error ---> Key not found!!");
         }
+        return found_node->_value->second;
     }
 
     /*
@@ -697,7 +1107,7 @@ namespace nm {
             }
 
             // Logic to manage forward pointers
-            temp_node = new SkipNode<K, M>(new_level, new_pair);
+            temp_node = create_node(new_level, new_pair);
             for (int i = 0; i <= new_level; ++i) {
                 temp_node->_fwd_nodes[i] = updated_nodes[i]->_fwd_nodes[i];
                 updated_nodes[i]->_fwd_nodes[i] = temp_node;
@@ -772,7 +1182,7 @@ namespace nm {
                     temp_node->_fwd_nodes[LOWEST_LEVEL]->_prev_node = temp_node->_prev_node;
                 }
                 // Delete respective node with passed Key
-                delete temp_node;
+                destroy_node(temp_node);
                 // Update modified level of Map (skip list)
                 while (_map_level > 0 && _head_node->_fwd_nodes[_map_level] == _tail_node) {
                     --_map_level;
@@ -825,7 +1235,7 @@ namespace nm {
                 temp_node->_fwd_nodes[LOWEST_LEVEL]->_prev_node = temp_node->_prev_node;
             }
             // Delete respective node with passed Key
-            delete temp_node;
+            destroy_node(temp_node);
             // Update modified level of Map (skip list)
             while (_map_level > 0 && _head_node->_fwd_nodes[_map_level] == _tail_node) {
                 --_map_level;
@@ -840,13 +1250,166 @@ namespace nm {
         }
     }
 
+    /*
+     * Function to remove the first element of Map
+     * Predecessors of the first node are the head node on every level, so no search is needed
+     */
+    template<typename K, typename M>
+    typename Map<K, M>::ValueType Map<K, M>::pop_front() {
+        if (empty()) {
+            throw std::out_of_range("Pop Error ---> Map is empty!!");
+        }
+        SkipNode<K, M> *first_node = _head_node->_fwd_nodes[LOWEST_LEVEL];
+        ValueType popped_value(std::move(*first_node->_value));
+        for (int lvl = 0; lvl <= first_node->_level_node; ++lvl) {
+            _head_node->_fwd_nodes[lvl] = first_node->_fwd_nodes[lvl];
+        }
+        first_node->_fwd_nodes[LOWEST_LEVEL]->_prev_node = _head_node;
+        destroy_node(first_node);
+        // Update modified level of Map (upper level lists end with nullptr)
+        while (_map_level > 0 && _head_node->_fwd_nodes[_map_level] == nullptr) {
+            --_map_level;
+        }
+        --_num_of_elements;
+        return popped_value;
+    }
+
+    /*
+     * Function to remove the last element of Map
+     */
+    template<typename K, typename M>
+    typename Map<K, M>::ValueType Map<K, M>::pop_back() {
+        if (empty()) {
+            throw std::out_of_range("Pop Error ---> Map is empty!!");
+        }
+        SkipNode<K, M> *last_node = _tail_node->_prev_node;
+        // Key is const so it stays valid for the search done by erase
+        ValueType popped_value(std::move(*last_node->_value));
+        erase(Iterator{last_node});
+        return popped_value;
+    }
+
+    /*
+     * Function to remove a batch of the smallest elements of Map
+     */
+    template<typename K, typename M>
+    template<typename OUT_IT>
+    size_t Map<K, M>::extract_min(size_t count, OUT_IT out) {
+        if (count > _num_of_elements) {
+            count = _num_of_elements;
+        }
+        if (count == 0) {
+            return 0;
+        }
+        // Hand out the elements in order while they are still linked, so a throwing write leaves the Map consistent
+        // Values are moved only when that cannot throw, otherwise the element stays intact in the Map
+        SkipNode<K, M> *cut_node = _head_node->_fwd_nodes[LOWEST_LEVEL];
+        size_t handed_out = 0;
+        try {
+            for (; handed_out < count; ++handed_out) {
+                *out = std::move_if_noexcept(*cut_node->_value);
+                ++out;
+                cut_node = cut_node->_fwd_nodes[LOWEST_LEVEL];
+            }
+        } catch (...) {
+            unlink_front(cut_node, handed_out);
+            throw;
+        }
+        unlink_front(cut_node, count);
+        return count;
+    }
+
+    /*
+     * Function to remove the count first nodes of Map, cut_node is the first node which stays
+     * All of them are cut off the head tower at once
+     */
+    template<typename K, typename M>
+    void Map<K, M>::unlink_front(SkipNode<K, M> *cut_node, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        SkipNode<K, M> *first_node = _head_node->_fwd_nodes[LOWEST_LEVEL];
+        // On every level skip the removed nodes, they are exactly the nodes with keys less than cut node key
+        for (int lvl = 0; lvl <= _map_level; ++lvl) {
+            SkipNode<K, M> *temp_node = _head_node->_fwd_nodes[lvl];
+            while (temp_node != nullptr && temp_node != cut_node && temp_node != _tail_node
+                   && (cut_node == _tail_node || temp_node->_value->first < cut_node->_value->first)) {
+                temp_node = temp_node->_fwd_nodes[lvl];
+            }
+            _head_node->_fwd_nodes[lvl] = temp_node;
+        }
+        cut_node->_prev_node = _head_node;
+        while (first_node != cut_node) {
+            SkipNode<K, M> *next_node = first_node->_fwd_nodes[LOWEST_LEVEL];
+            destroy_node(first_node);
+            first_node = next_node;
+        }
+        while (_map_level > 0 && _head_node->_fwd_nodes[_map_level] == nullptr) {
+            --_map_level;
+        }
+        _num_of_elements -= count;
+    }
+
     /*
      * Function to clear all the elements of Map
      */
     template<typename K, typename M>
     void Map<K, M>::clear() {
+        size_t hot_slots = hot_cache_capacity();
         DESTROY_ALLOCATIONS
         MEMBER_INIT_CTOR
+        enable_hot_cache(hot_slots);
+    }
+
+    /*
+     * Function to enable the hot key cache with the requested number of slots
+     */
+    template<typename K, typename M>
+    void Map<K, M>::enable_hot_cache(size_t slots) {
+        disable_hot_cache();
+        if (slots == 0 || !is_hashable<K>::value) {
+            return;
+        }
+        // Round up to power of two so that slot index is taken from top bits of the mixed hash
+        size_t capacity = 1;
+        int bits = 0;
+        while (capacity < slots) {
+            capacity <<= 1;
+            ++bits;
+        }
+        _hot_cache = new HotSlot[capacity];
+        memset(static_cast<void *>(_hot_cache), '\0', capacity * sizeof(HotSlot));
+        _hot_cache_mask = capacity - 1;
+        _hot_cache_shift = (bits == 0) ? 63 : 64 - bits;
+        report_allocation(static_cast<std::ptrdiff_t>(capacity * sizeof(HotSlot)));
+    }
+
+    /*
+     * Function to disable the hot key cache
+     */
+    template<typename K, typename M>
+    void Map<K, M>::disable_hot_cache() {
+        if (_hot_cache != nullptr) {
+            report_allocation(-static_cast<std::ptrdiff_t>(hot_cache_capacity() * sizeof(HotSlot)));
+            delete[] _hot_cache;
+            _hot_cache = nullptr;
+            _hot_cache_mask = 0;
+            _hot_cache_shift = 0;
+        }
+    }
+
+    /*
+     * Function to report memory used by the Map
+     */
+    template<typename K, typename M>
+    MapMemoryUsage Map<K, M>::memory_usage() const {
+        MapMemoryUsage usage;
+        usage.node_bytes = _num_of_elements * sizeof(SkipNode<K, M>);
+        usage.tower_bytes = _tower_slots * sizeof(SkipNode<K, M> *);
+        usage.value_bytes = _num_of_elements * sizeof(ValueType);
+        usage.overhead_bytes = sizeof(Map<K, M>) + fixed_heap_bytes() + hot_cache_capacity() * sizeof(HotSlot);
+        usage.total_bytes = usage.node_bytes + usage.tower_bytes + usage.value_bytes + usage.overhead_bytes;
+        return usage;
     }
 
     /*
@@ -854,8 +1417,8 @@ namespace nm {
      */
     template<typename K, typename M>
     bool operator==(const Map<K, M> &map_1, const Map<K, M> &map_2) {
-        bool is_equal = false;
-        if (map_1.size() == map_2.size()) {
+        bool is_equal = (map_1.size() == map_2.size());
+        if (is_equal) {
             // Traverse through both maps and check for every corresponding object types
             //auto map_1_iter, map_2_iter;
             for (auto map_1_iter = map_1.begin(), map_2_iter = map_2.begin();
@@ -864,8 +1427,6 @@ namespace nm {
                 // Compare the elements using dereference
                 if (*map_1_iter != *map_2_iter) {
                     return false;
-                } else {
-                    is_equal = true;
                 }
             }
         }
@@ -899,6 +1460,128 @@ namespace nm {
         // If all elements are equal and size of M1 is less than M2 then return true otherwise false
         return (map_1.size() < map_2.size());
     }
+
+    /*
+     * Function to check equality of two Maps on several threads
+     */
+    template<typename K, typename M>
+    bool parallel_equal(const Map<K, M> &map_1, const Map<K, M> &map_2, unsigned threads) {
+        if (map_1.size() != map_2.size()) {
+            return false;
+        }
+        return Map<K, M>::parallel_compare(map_1, map_2, threads, false) == 0;
+    }
+
+    /*
+     * Function to compare two Maps on several threads
+     */
+    template<typename K, typename M>
+    bool parallel_less(const Map<K, M> &map_1, const Map<K, M> &map_2, unsigned threads) {
+        int result = Map<K, M>::parallel_compare(map_1, map_2, threads, true);
+        if (result != 0) {
+            return result < 0;
+        }
+        return (map_1.size() < map_2.size());
+    }
+
+    /*
+     * Implementation of Map Range class template
+     * Half-open range of consecutive Map elements, created by Map::range() and Map::split_ranges()
+    */
+    template<typename K, typename M>
+    class MapRange {
+    public:
+        typedef typename Map<K, M>::Iterator Iterator;
+
+        MapRange(const Iterator &range_beg, const Iterator &range_end) : _range_beg{range_beg}, _range_end{range_end} {}
+
+        Iterator begin() const {
+            return _range_beg;
+        }
+
+        Iterator end() const {
+            return _range_end;
+        }
+
+        bool empty() const {
+            return (_range_beg == _range_end);
+        }
+
+    private:
+        Iterator _range_beg;
+        Iterator _range_end;
+    };
+
+    template<typename K, typename M>
+    MapRange<K, M> Map<K, M>::range() {
+        return MapRange<K, M>{begin(), end()};
+    }
+
+    /*
+     * Function to cut the Map into consecutive ranges at tower nodes
+     */
+    template<typename K, typename M>
+    std::vector<MapRange<K, M>> Map<K, M>::split_ranges(size_t parts) {
+        std::vector<SkipNode<K, M> *> splits;
+        split_nodes(parts, splits);
+        std::vector<MapRange<K, M>> ranges;
+        SkipNode<K, M> *range_beg = _head_node->_fwd_nodes[LOWEST_LEVEL];
+        for (SkipNode<K, M> *split_node : splits) {
+            ranges.push_back(MapRange<K, M>{Iterator{range_beg}, Iterator{split_node}});
+            range_beg = split_node;
+        }
+        ranges.push_back(MapRange<K, M>{Iterator{range_beg}, end()});
+        return ranges;
+    }
+
+    /*
+     * Function to apply fn to every element of the Map on several threads (0 uses hardware concurrency)
+     * The map is cut into balanced ranges which the threads claim through an atomic counter, so no locks are taken
+     * fn must be safe to call concurrently on different elements, the map must not be modified meanwhile
+     * The first exception thrown by fn is rethrown once all threads are done
+     */
+    template<typename K, typename M, typename Fn>
+    void parallel_for_each(Map<K, M> &map, Fn fn, unsigned threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        if (threads <= 1 || map.size() < PARALLEL_MIN_ELEMENTS) {
+            for (auto &element : map) {
+                fn(element);
+            }
+            return;
+        }
+
+        std::vector<MapRange<K, M>> ranges = map.split_ranges((size_t) threads * PARALLEL_CHUNKS_PER_THREAD);
+        std::atomic<size_t> next_range{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr first_error;
+        auto worker = [&]() {
+            size_t index;
+            while (!failed.load(std::memory_order_relaxed) && (index = next_range.fetch_add(1)) < ranges.size()) {
+                try {
+                    for (auto &element : ranges[index]) {
+                        fn(element);
+                    }
+                } catch (...) {
+                    if (!failed.exchange(true)) {
+                        first_error = std::current_exception();
+                    }
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; ++i) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : workers) {
+            thread.join();
+        }
+        if (first_error) {
+            std::rethrow_exception(first_error);
+        }
+    }
 }
 
 #endif
\ No newline at end of file
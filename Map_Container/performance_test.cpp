@@ -0,0 +1,295 @@
+/*
+ * Benchmark of nm::Map against std::map, std::unordered_map and a sorted std::vector
+ * Usage: ./perf_exec [max_keys]   (key counts from 1K up to max_keys, at most 50M)
+ * Results are written to stdout as CSV:
+ *   container,distribution,operation,keys,ops,total_ns,ns_per_op
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <string>
+#include "map.hpp"
+#include "compact_map.hpp"
+
+#define DEFAULT_MAX_KEYS 100000
+#define MAX_LOOKUP_OPS 1000000
+#define MAX_ERASE_OPS 10000
+#define ZIPF_THETA 0.99
+#define HOT_CACHE_SLOTS 4096
+
+typedef uint64_t KeyType;
+typedef uint64_t MappedType;
+
+using Clock = std::chrono::steady_clock;
+
+// Sink to keep the compiler from discarding benchmarked work
+static volatile uint64_t benchmark_sink = 0;
+
+/*
+ * Zipfian index generator over [0, n) (Gray et al., as used by YCSB)
+ */
+class ZipfGenerator {
+public:
+    ZipfGenerator(size_t n, double theta) : _n{n}, _theta{theta} {
+        double zeta_2 = zeta(2);
+        _zeta_n = zeta(n);
+        _alpha = 1.0 / (1.0 - theta);
+        _eta = (1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta_2 / _zeta_n);
+    }
+
+    size_t next(std::mt19937_64 &engine) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(engine);
+        double uz = u * _zeta_n;
+        if (uz < 1.0) {
+            return 0;
+        }
+        if (uz < 1.0 + std::pow(0.5, _theta)) {
+            return 1;
+        }
+        size_t index = (size_t) (_n * std::pow(_eta * u - _eta + 1.0, _alpha));
+        return index < _n ? index : _n - 1;
+    }
+
+private:
+    double zeta(size_t n) const {
+        double sum = 0.0;
+        for (size_t i = 1; i <= n; ++i) {
+            sum += 1.0 / std::pow((double) i, _theta);
+        }
+        return sum;
+    }
+
+    size_t _n;
+    double _theta;
+    double _zeta_n;
+    double _alpha;
+    double _eta;
+};
+
+/*
+ * Keys used by one benchmark run
+ * Present keys are even, keys used for misses are odd
+ */
+struct Workload {
+    std::string distribution;
+    std::vector<KeyType> insert_keys;   // Keys in insertion order
+    std::vector<KeyType> hit_keys;      // Lookup sequence of present keys
+    std::vector<KeyType> miss_keys;     // Lookup sequence of absent keys
+    std::vector<KeyType> erase_keys;    // Distinct present keys to erase
+};
+
+Workload make_workload(const std::string &distribution, size_t num_keys, std::mt19937_64 &engine) {
+    Workload work;
+    work.distribution = distribution;
+    size_t lookup_ops = std::min<size_t>(num_keys, MAX_LOOKUP_OPS);
+    size_t erase_ops = std::min<size_t>(num_keys, MAX_ERASE_OPS);
+
+    std::vector<KeyType> sorted_keys(num_keys);
+    for (size_t i = 0; i < num_keys; ++i) {
+        sorted_keys[i] = 2 * (KeyType) i;
+    }
+
+    if (distribution == "sequential") {
+        // Ascending inserts and ascending lookups
+        work.insert_keys = sorted_keys;
+        for (size_t i = 0; i < lookup_ops; ++i) {
+            work.hit_keys.push_back(sorted_keys[i]);
+            work.miss_keys.push_back(sorted_keys[i] + 1);
+        }
+        work.erase_keys.assign(sorted_keys.begin(), sorted_keys.begin() + erase_ops);
+        return work;
+    }
+
+    // Uniform and Zipfian both insert in random order
+    work.insert_keys = sorted_keys;
+    std::shuffle(work.insert_keys.begin(), work.insert_keys.end(), engine);
+    std::uniform_int_distribution<size_t> uniform(0, num_keys - 1);
+    if (distribution == "uniform") {
+        for (size_t i = 0; i < lookup_ops; ++i) {
+            work.hit_keys.push_back(sorted_keys[uniform(engine)]);
+            work.miss_keys.push_back(sorted_keys[uniform(engine)] + 1);
+        }
+    } else {
+        // Hot ranks are mapped through the shuffled order so hot keys are scattered over the key space
+        ZipfGenerator zipf(num_keys, ZIPF_THETA);
+        for (size_t i = 0; i < lookup_ops; ++i) {
+            work.hit_keys.push_back(work.insert_keys[zipf.next(engine)]);
+            work.miss_keys.push_back(work.insert_keys[zipf.next(engine)] + 1);
+        }
+    }
+    work.erase_keys.assign(work.insert_keys.begin(), work.insert_keys.begin() + erase_ops);
+    return work;
+}
+
+void report(const char *container, const Workload &work, const char *operation, size_t num_keys, size_t ops,
+            Clock::time_point start, Clock::time_point end) {
+    long long total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    printf("%s,%s,%s,%zu,%zu,%lld,%.2f\n", container, work.distribution.c_str(), operation, num_keys, ops,
+           total_ns, ops == 0 ? 0.0 : (double) total_ns / ops);
+    fflush(stdout);
+}
+
+/*
+ * Container adapters giving every container the same benchmark interface
+ */
+struct NmMapAdapter {
+    typedef nm::Map<KeyType, MappedType> Container;
+    static const char *name() { return "nm::Map"; }
+    static void insert(Container &c, KeyType key) { c.insert({key, key}); }
+    static bool find(const Container &c, KeyType key) { return c.find(key) != c.end(); }
+    static void erase(Container &c, KeyType key) { c.erase(key); }
+    static void prepare(Container &) {}
+};
+
+// nm::Map with hot key cache enabled once it is populated
+struct NmMapHotCacheAdapter : NmMapAdapter {
+    static const char *name() { return "nm::Map(hot_cache)"; }
+    // Non-const find so lookups go through the cache admission path
+    static bool find(Container &c, KeyType key) { return c.find(key) != c.end(); }
+    static void prepare(Container &c) { c.enable_hot_cache(HOT_CACHE_SLOTS); }
+};
+
+struct NmCompactMapAdapter {
+    typedef nm::CompactMap<KeyType, MappedType> Container;
+    static const char *name() { return "nm::CompactMap"; }
+    static void insert(Container &c, KeyType key) { c.insert({key, key}); }
+    static bool find(const Container &c, KeyType key) { return c.find(key) != c.end(); }
+    static void erase(Container &c, KeyType key) { c.erase(key); }
+    static void prepare(Container &) {}
+};
+
+struct StdMapAdapter {
+    typedef std::map<KeyType, MappedType> Container;
+    static const char *name() { return "std::map"; }
+    static void insert(Container &c, KeyType key) { c.insert({key, key}); }
+    static bool find(const Container &c, KeyType key) { return c.find(key) != c.end(); }
+    static void erase(Container &c, KeyType key) { c.erase(key); }
+    static void prepare(Container &) {}
+};
+
+struct StdUnorderedMapAdapter {
+    typedef std::unordered_map<KeyType, MappedType> Container;
+    static const char *name() { return "std::unordered_map"; }
+    static void insert(Container &c, KeyType key) { c.insert({key, key}); }
+    static bool find(const Container &c, KeyType key) { return c.find(key) != c.end(); }
+    static void erase(Container &c, KeyType key) { c.erase(key); }
+    static void prepare(Container &) {}
+};
+
+// Sorted vector is built by appending and sorting once, which is how it is used in practice
+struct SortedVectorAdapter {
+    typedef std::vector<std::pair<KeyType, MappedType>> Container;
+    static const char *name() { return "sorted_vector"; }
+    static void insert(Container &c, KeyType key) { c.push_back({key, key}); }
+    static bool find(const Container &c, KeyType key) {
+        auto iter = std::lower_bound(c.begin(), c.end(), std::make_pair(key, (MappedType) 0));
+        return iter != c.end() && iter->first == key;
+    }
+    static void erase(Container &c, KeyType key) {
+        auto iter = std::lower_bound(c.begin(), c.end(), std::make_pair(key, (MappedType) 0));
+        c.erase(iter);
+    }
+    static void prepare(Container &c) { std::sort(c.begin(), c.end()); }
+};
+
+template<typename Adapter>
+void run_benchmark(const Workload &work, size_t num_keys) {
+    typedef typename Adapter::Container Container;
+    const char *name = Adapter::name();
+    uint64_t checksum = 0;
+    Clock::time_point start, end;
+
+    Container *container = new Container;
+    start = Clock::now();
+    for (KeyType key : work.insert_keys) {
+        Adapter::insert(*container, key);
+    }
+    Adapter::prepare(*container);
+    end = Clock::now();
+    report(name, work, "insert", num_keys, work.insert_keys.size(), start, end);
+
+    start = Clock::now();
+    for (KeyType key : work.hit_keys) {
+        checksum += Adapter::find(*container, key);
+    }
+    end = Clock::now();
+    assert(checksum == work.hit_keys.size());
+    report(name, work, "find_hit", num_keys, work.hit_keys.size(), start, end);
+
+    start = Clock::now();
+    for (KeyType key : work.miss_keys) {
+        checksum += Adapter::find(*container, key);
+    }
+    end = Clock::now();
+    assert(checksum == work.hit_keys.size());
+    report(name, work, "find_miss", num_keys, work.miss_keys.size(), start, end);
+
+    start = Clock::now();
+    for (const auto &element : *container) {
+        checksum += element.second;
+    }
+    end = Clock::now();
+    report(name, work, "iterate", num_keys, num_keys, start, end);
+
+    start = Clock::now();
+    Container *copy = new Container(*container);
+    end = Clock::now();
+    report(name, work, "copy", num_keys, num_keys, start, end);
+
+    start = Clock::now();
+    for (KeyType key : work.erase_keys) {
+        Adapter::erase(*container, key);
+    }
+    end = Clock::now();
+    assert(container->size() == num_keys - work.erase_keys.size());
+    report(name, work, "erase", num_keys, work.erase_keys.size(), start, end);
+
+    start = Clock::now();
+    copy->clear();
+    end = Clock::now();
+    assert(copy->empty());
+    report(name, work, "clear", num_keys, num_keys, start, end);
+
+    delete copy;
+    delete container;
+    benchmark_sink = benchmark_sink + checksum;
+}
+
+int main(int argc, char *argv[]) {
+
+    size_t max_keys = DEFAULT_MAX_KEYS;
+    if (argc > 1) {
+        max_keys = strtoull(argv[1], nullptr, 10);
+    }
+
+    const size_t key_counts[] = {1000, 10000, 100000, 1000000, 10000000, 50000000};
+    const char *distributions[] = {"sequential", "uniform", "zipfian"};
+    std::mt19937_64 engine(42);
+
+    printf("container,distribution,operation,keys,ops,total_ns,ns_per_op\n");
+    for (size_t num_keys : key_counts) {
+        if (num_keys > max_keys) {
+            break;
+        }
+        for (const char *distribution : distributions) {
+            Workload work = make_workload(distribution, num_keys, engine);
+            run_benchmark<NmMapAdapter>(work, num_keys);
+            run_benchmark<NmMapHotCacheAdapter>(work, num_keys);
+            run_benchmark<NmCompactMapAdapter>(work, num_keys);
+            run_benchmark<StdMapAdapter>(work, num_keys);
+            run_benchmark<StdUnorderedMapAdapter>(work, num_keys);
+            run_benchmark<SortedVectorAdapter>(work, num_keys);
+        }
+    }
+
+    return 0;
+}
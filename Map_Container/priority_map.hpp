@@ -0,0 +1,117 @@
+#ifndef NITESH_PRIORITY_MAP_HPP
+#define NITESH_PRIORITY_MAP_HPP
+
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include "map.hpp"
+
+#define STAGING_STRIPES 8
+#define CACHE_LINE_SIZE 64
+
+namespace nm {
+
+    /*
+     * Implementation of Concurrent Priority Map class template
+     * Several producers push elements while a consumer removes the smallest ones in batches.
+     * Producers only append to one of several striped staging buffers (chosen by thread id), so they never
+     * wait on the skip list. The consumer merges the staged elements into the Map when it extracts.
+     * Elements with equal keys (e.g. timers with the same deadline) are all kept: the Map key is the pair of key and a
+     * sequence number assigned at merge, so elements pushed by one thread with equal keys come out in push order.
+    */
+    template<typename K, typename M>
+    class ConcurrentPriorityMap {
+    public:
+        typedef std::pair<const K, M> ValueType;
+
+        ConcurrentPriorityMap() = default;
+        ConcurrentPriorityMap(const ConcurrentPriorityMap &) = delete; // Copy ctor
+        ConcurrentPriorityMap &operator=(const ConcurrentPriorityMap &) = delete; // Assignment operator
+
+        // Stages the pair for insertion (safe to call from any number of threads)
+        void push(const std::pair<K, M> &new_pair) {
+            StagingStripe &stripe = _stripes[std::hash<std::thread::id>()(std::this_thread::get_id()) % STAGING_STRIPES];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            stripe.staged.push_back(new_pair);
+        }
+
+        // Removes up to count smallest elements (including staged ones) writing them to out
+        // Returns number of removed elements
+        template<typename OUT_IT>
+        size_t extract_min(size_t count, OUT_IT out) {
+            std::lock_guard<std::mutex> lock(_map_mutex);
+            merge_staged();
+            return _map.extract_min(count, KeyOutput<OUT_IT>{out});
+        }
+
+        // Removes the smallest element into value, returns false if there is none
+        bool pop_front(std::pair<K, M> &value) {
+            std::lock_guard<std::mutex> lock(_map_mutex);
+            merge_staged();
+            if (_map.empty()) {
+                return false;
+            }
+            typename Map<SequencedKey, M>::ValueType popped_value = _map.pop_front();
+            value.first = popped_value.first.first;
+            value.second = std::move(popped_value.second);
+            return true;
+        }
+
+        // Returns number of elements merged into the Map (staged elements are not counted)
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(_map_mutex);
+            return _map.size();
+        }
+
+    private:
+        // Map key, sequence number orders elements with equal keys
+        typedef std::pair<K, uint64_t> SequencedKey;
+
+        // Output iterator writing Map elements to out without their sequence number
+        template<typename OUT_IT>
+        struct KeyOutput {
+            OUT_IT out;
+
+            KeyOutput &operator*() { return *this; }
+
+            KeyOutput &operator++() { return *this; }
+
+            template<typename V>
+            KeyOutput &operator=(V &&element) {
+                *out = std::pair<K, M>(element.first.first, std::forward<V>(element).second);
+                ++out;
+                return *this;
+            }
+        };
+
+        // Staging buffer with its own lock, aligned so that stripes do not share cache lines
+        struct alignas(CACHE_LINE_SIZE) StagingStripe {
+            std::mutex mutex;
+            std::vector<std::pair<K, M>> staged;
+        };
+
+        // Move staged elements of all stripes into the Map, stripe locks are held only for a swap
+        void merge_staged() {
+            for (StagingStripe &stripe : _stripes) {
+                _merge_buffer.clear();
+                {
+                    std::lock_guard<std::mutex> lock(stripe.mutex);
+                    _merge_buffer.swap(stripe.staged);
+                }
+                for (const std::pair<K, M> &staged_pair : _merge_buffer) {
+                    _map.insert({SequencedKey(staged_pair.first, _next_sequence++), staged_pair.second});
+                }
+            }
+        }
+
+        StagingStripe _stripes[STAGING_STRIPES];
+        mutable std::mutex _map_mutex;
+        std::vector<std::pair<K, M>> _merge_buffer;
+        uint64_t _next_sequence = 0;
+        Map<SequencedKey, M> _map;
+    };
+}
+
+#endif
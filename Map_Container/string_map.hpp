@@ -0,0 +1,620 @@
+#ifndef NITESH_STRING_MAP_HPP
+#define NITESH_STRING_MAP_HPP
+
+#include <string>
+#include <cstring>
+#include <stdexcept>
+#include "map.hpp"
+
+#define STRING_MAP_PROB 0.25
+
+namespace nm {
+
+    // Forward declaration of String Map class template
+    template<typename M>
+    class StringMap;
+
+    /*
+     * Implementation of Prefix Node class template
+     * Nodes of level 0 store their key front coded against the key of the previous node
+     * (number of leading characters shared with it followed by the remaining suffix).
+     * Nodes of higher levels are reached directly by the descent, so they store their full key (shared length 0).
+    */
+    template<typename M>
+    class PrefixNode {
+    public:
+        friend class StringMap<M>;
+
+        PrefixNode() = delete; // Default ctor
+        PrefixNode(const PrefixNode &) = delete; // Copy ctor
+        PrefixNode &operator=(const PrefixNode &) = delete; // Assignment operator
+
+        PrefixNode(int level) : _shared_len{0}, _suffix_len{0}, _suffix{nullptr}, _mapped{},
+                                _prev_node{nullptr}, _level_node{level} {
+            // Allocate memory for forward nodes and initialize them to point nullptr
+            _fwd_nodes = new PrefixNode<M> *[level + 1];
+            for (int i = 0; i <= level; ++i) {
+                _fwd_nodes[i] = (PrefixNode<M> *) nullptr;
+            }
+        }
+
+        PrefixNode(int level, const M &mapped) : PrefixNode(level) {
+            _mapped = mapped;
+        }
+
+        ~PrefixNode() {
+            delete[] _fwd_nodes;
+            delete[] _suffix;
+        }
+
+        // Replace the stored key by (shared, suffix)
+        void set_key(size_t shared_len, const char *suffix, size_t suffix_len) {
+            char *new_suffix = (suffix_len != 0) ? new char[suffix_len] : nullptr;
+            if (suffix_len != 0) {
+                memcpy(new_suffix, suffix, suffix_len);
+            }
+            delete[] _suffix;
+            _suffix = new_suffix;
+            _shared_len = (uint32_t) shared_len;
+            _suffix_len = (uint32_t) suffix_len;
+        }
+
+        // Key length once decoded
+        size_t key_length() const {
+            return _shared_len + _suffix_len;
+        }
+
+        // Decode the key given the key of the previous node
+        void decode_key(std::string &prev_key) const {
+            prev_key.resize(_shared_len);
+            prev_key.append(_suffix, _suffix_len);
+        }
+
+    private:
+        uint32_t _shared_len; // Leading characters shared with the key of the previous node
+        uint32_t _suffix_len; // Number of characters stored in _suffix
+        char *_suffix; // Remaining characters of the key
+        M _mapped; // Mapped object
+        PrefixNode **_fwd_nodes; // Link to forward nodes in the skip list
+        PrefixNode *_prev_node; // Link to previous node in the skip list
+        int _level_node; // Level of each skip node
+    };
+
+    /*
+     * Implementation of String Map class template (std::string keys stored with front coding) using Skip List
+     * Iterators decode keys on the fly, so they expose key() and value() instead of a stored std::pair
+     * Map support bidirectional iterators
+    */
+    template<typename M>
+    class StringMap {
+    public:
+        typedef std::pair<const std::string, M> ValueType;
+
+        StringMap() {
+            init_members();
+        }
+
+        StringMap(const StringMap &existing_map) {
+            init_members();
+            insert_all(existing_map);
+        }
+
+        StringMap(std::initializer_list<ValueType> init_list) {
+            init_members();
+            for (const ValueType &value : init_list) {
+                insert(value);
+            }
+        }
+
+        StringMap &operator=(const StringMap &existing_map) {
+            // Handling self assignment of map objects
+            if (this != &existing_map) {
+                destroy_members();
+                init_members();
+                insert_all(existing_map);
+            }
+            return *this;
+        }
+
+        ~StringMap() {
+            destroy_members();
+        }
+
+        /*
+         * Implementation of Nested Iterator class (keeps decoded key of the current element)
+        */
+        class Iterator {
+        public:
+            Iterator() = delete; // Default ctor
+            Iterator(PrefixNode<M> *iter_ptr, PrefixNode<M> *tail_node) : _iter_ptr{iter_ptr}, _tail_node{tail_node} {
+                decode_current();
+            }
+            Iterator(PrefixNode<M> *iter_ptr, PrefixNode<M> *tail_node, const std::string &key)
+                    : _iter_ptr{iter_ptr}, _tail_node{tail_node}, _key{key} {}
+
+            PrefixNode<M> *get_iter_ptr() const {
+                return _iter_ptr;
+            }
+
+            // Returns a reference to the incremented iterator (preincrement)
+            Iterator &operator++() {
+                if (_iter_ptr != _tail_node) {
+                    _iter_ptr = _iter_ptr->_fwd_nodes[LOWEST_LEVEL];
+                    if (_iter_ptr != _tail_node) {
+                        // Front coded keys only need the key of the previous element
+                        _iter_ptr->decode_key(_key);
+                    }
+                }
+                return *this;
+            }
+
+            // Returns an iterator pointing to the element prior to incrementing (postincrement)
+            Iterator operator++(int) {
+                Iterator temp_iter{*this};
+                ++(*this);
+                return temp_iter;
+            }
+
+            // Returns a reference to the decremented iterator (predecrement)
+            Iterator &operator--() {
+                if (_iter_ptr->_prev_node != nullptr && _iter_ptr->_prev_node->_prev_node != nullptr) {
+                    _iter_ptr = _iter_ptr->_prev_node;
+                    decode_current();
+                }
+                return *this;
+            }
+
+            // Returns an iterator pointing to the element prior to decrementing (postdecrement)
+            Iterator operator--(int) {
+                Iterator temp_iter{*this};
+                --(*this);
+                return temp_iter;
+            }
+
+            // Returns the decoded key of the element
+            const std::string &key() const {
+                return _key;
+            }
+
+            // Returns a reference to the mapped object of the element
+            M &value() const {
+                return _iter_ptr->_mapped;
+            }
+
+            friend bool operator==(const Iterator &iter_1, const Iterator &iter_2) {
+                return (iter_1._iter_ptr == iter_2._iter_ptr);
+            }
+
+            friend bool operator!=(const Iterator &iter_1, const Iterator &iter_2) {
+                return (iter_1._iter_ptr != iter_2._iter_ptr);
+            }
+
+        private:
+            // Walk back to the closest node storing a full key, then decode forward
+            void decode_current() {
+                _key.clear();
+                if (_iter_ptr == _tail_node) {
+                    return;
+                }
+                PrefixNode<M> *start_node = _iter_ptr;
+                while (start_node->_level_node == LOWEST_LEVEL && start_node->_prev_node->_prev_node != nullptr) {
+                    start_node = start_node->_prev_node;
+                }
+                for (PrefixNode<M> *node = start_node;; node = node->_fwd_nodes[LOWEST_LEVEL]) {
+                    node->decode_key(_key);
+                    if (node == _iter_ptr) {
+                        break;
+                    }
+                }
+            }
+
+            PrefixNode<M> *_iter_ptr;
+            PrefixNode<M> *_tail_node;
+            std::string _key;
+        };
+
+        /*
+         * Implementation of Nested ConstIterator class (Iterator giving read only access to mapped objects)
+        */
+        class ConstIterator {
+        public:
+            ConstIterator() = delete; // Default ctor
+            ConstIterator(const Iterator &iter) : _iter{iter} {} // Conversion ctor
+
+            PrefixNode<M> *get_iter_ptr() const {
+                return _iter.get_iter_ptr();
+            }
+
+            // Returns a reference to the incremented ConstIterator (preincrement)
+            ConstIterator &operator++() {
+                ++_iter;
+                return *this;
+            }
+
+            // Returns a ConstIterator pointing to the element prior to incrementing (postincrement)
+            ConstIterator operator++(int) {
+                ConstIterator temp_iter{*this};
+                ++_iter;
+                return temp_iter;
+            }
+
+            // Returns a reference to the decremented ConstIterator (predecrement)
+            ConstIterator &operator--() {
+                --_iter;
+                return *this;
+            }
+
+            // Returns a ConstIterator pointing to the element prior to decrementing (postdecrement)
+            ConstIterator operator--(int) {
+                ConstIterator temp_iter{*this};
+                --_iter;
+                return temp_iter;
+            }
+
+            // Returns the decoded key of the element
+            const std::string &key() const {
+                return _iter.key();
+            }
+
+            // Returns a const reference to the mapped object of the element
+            const M &value() const {
+                return _iter.value();
+            }
+
+            friend bool operator==(const ConstIterator &const_iter_1, const ConstIterator &const_iter_2) {
+                return (const_iter_1.get_iter_ptr() == const_iter_2.get_iter_ptr());
+            }
+
+            friend bool operator!=(const ConstIterator &const_iter_1, const ConstIterator &const_iter_2) {
+                return (const_iter_1.get_iter_ptr() != const_iter_2.get_iter_ptr());
+            }
+
+        private:
+            Iterator _iter;
+        };
+
+        // Return number of elements in the map (size of Map)
+        size_t size() const {
+            return _num_of_elements;
+        }
+
+        // Returns true if the Map has no entries in it, false otherwise
+        bool empty() const {
+            return (_num_of_elements == 0);
+        }
+
+        // Returns an Iterator pointing to the first element, in order
+        Iterator begin() {
+            return Iterator{_head_node->_fwd_nodes[LOWEST_LEVEL], _tail_node};
+        }
+
+        // Returns a ConstIterator pointing to the first element, in order
+        ConstIterator begin() const {
+            return Iterator{_head_node->_fwd_nodes[LOWEST_LEVEL], _tail_node};
+        }
+
+        // Returns an Iterator pointing one past the last element, in order
+        Iterator end() {
+            return Iterator{_tail_node, _tail_node, std::string()};
+        }
+
+        // Returns a ConstIterator pointing one past the last element, in order
+        ConstIterator end() const {
+            return Iterator{_tail_node, _tail_node, std::string()};
+        }
+
+        // Returns an iterator to the given key (key is not found, return the end() iterator)
+        Iterator find(const std::string &find_key) {
+            PrefixNode<M> *found_node = locate(find_key, nullptr, nullptr);
+            if (found_node == nullptr) {
+                return end();
+            }
+            return Iterator{found_node, _tail_node, find_key};
+        }
+
+        // Returns a const iterator to the given key (key is not found, return the end() iterator)
+        ConstIterator find(const std::string &find_key) const {
+            PrefixNode<M> *found_node = locate(find_key, nullptr, nullptr);
+            if (found_node == nullptr) {
+                return end();
+            }
+            return Iterator{found_node, _tail_node, find_key};
+        }
+
+        // Returns a reference to the mapped object at the specified key (key is not in the Map, throws std::out_of_range)
+        M &at(const std::string &find_key) {
+            PrefixNode<M> *found_node = locate(find_key, nullptr, nullptr);
+            if (found_node == nullptr) {
+                throw std::out_of_range("Error ---> Key not found!!");
+            }
+            return found_node->_mapped;
+        }
+
+        // Returns a const reference to the mapped object at the specified key (throws std::out_of_range if missing)
+        const M &at(const std::string &find_key) const {
+            PrefixNode<M> *found_node = locate(find_key, nullptr, nullptr);
+            if (found_node == nullptr) {
+                throw std::out_of_range("Error ---> Key not found!!");
+            }
+            return found_node->_mapped;
+        }
+
+        // If key is in the map, return a reference to the corresponding mapped object
+        // If not, value initialize a mapped object for that key and returns a reference to it
+        M &operator[](const std::string &find_key) {
+            return insert(std::make_pair(find_key, M())).first.value();
+        }
+
+        // Inserts the given pair into the map.
+        // If the key does not exist, returns an iterator pointing to the new element and true
+        // If the key exists, returns an iterator pointing to the element with the same key and false.
+        std::pair<Iterator, bool> insert(const ValueType &);
+
+        // Removes the given object indicated by Iterator from the map
+        void erase(const Iterator &pos) {
+            if (pos.get_iter_ptr() != _tail_node) {
+                erase(pos.key());
+            }
+        }
+
+        // Removes the given object indicated by Key from the map
+        // Throws std::out_of_range if the key is not in the Map
+        void erase(const std::string &);
+
+        // Removes all elements from the map
+        void clear() {
+            destroy_members();
+            init_members();
+        }
+
+        // Returns number of bytes used by the map (value_bytes counts stored key characters, mapped objects live in nodes)
+        MapMemoryUsage memory_usage() const;
+
+    private:
+        // Length of common prefix of two character ranges
+        static size_t common_prefix(const char *str_1, size_t len_1, const char *str_2, size_t len_2) {
+            size_t len = (len_1 < len_2) ? len_1 : len_2, i = 0;
+            while (i < len && str_1[i] == str_2[i]) {
+                ++i;
+            }
+            return i;
+        }
+
+        // Compare key of a node holding a full key with the search key, also returning their common prefix
+        static int compare_full(const PrefixNode<M> *node, const std::string &find_key, size_t &common) {
+            common = common_prefix(node->_suffix, node->_suffix_len, find_key.data(), find_key.size());
+            if (common == node->_suffix_len) {
+                return (common == find_key.size()) ? 0 : -1;
+            }
+            if (common == find_key.size()) {
+                return 1;
+            }
+            return ((unsigned char) node->_suffix[common] < (unsigned char) find_key[common]) ? -1 : 1;
+        }
+
+        /*
+         * Find the node holding the key, otherwise nullptr
+         * Fills predecessors at every level and the decoded key of the level 0 predecessor if requested
+         * On level 0 the front coding is used to skip shared characters: with m being the common prefix of the
+         * search key and the current (smaller) key, a next node sharing more than m characters with the current
+         * key is smaller than the search key, one sharing less is greater, only equal lengths need comparing
+         */
+        PrefixNode<M> *locate(const std::string &find_key, PrefixNode<M> **updated_nodes, std::string *prev_key) const {
+            PrefixNode<M> *temp_node = _head_node;
+            size_t common = 0, next_common = 0;
+
+            // Upper levels only link nodes holding full keys
+            for (int lvl = _map_level; lvl > LOWEST_LEVEL; --lvl) {
+                PrefixNode<M> *next_node;
+                while ((next_node = temp_node->_fwd_nodes[lvl]) != nullptr && next_node != _tail_node
+                       && compare_full(next_node, find_key, next_common) < 0) {
+                    temp_node = next_node;
+                    common = next_common;
+                }
+                if (updated_nodes != nullptr) {
+                    updated_nodes[lvl] = temp_node;
+                }
+            }
+            if (prev_key != nullptr) {
+                prev_key->clear();
+                if (temp_node != _head_node) {
+                    temp_node->decode_key(*prev_key);
+                }
+            }
+
+            PrefixNode<M> *next_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
+            int result = 1;
+            while (next_node != _tail_node) {
+                if (next_node->_level_node != LOWEST_LEVEL) {
+                    result = compare_full(next_node, find_key, next_common);
+                } else if (next_node->_shared_len > common) {
+                    result = -1;
+                    next_common = common;
+                } else if (next_node->_shared_len < common) {
+                    result = 1;
+                } else {
+                    // Same shared length, compare only the stored suffix against the rest of the search key
+                    size_t suffix_common = common_prefix(next_node->_suffix, next_node->_suffix_len,
+                                                         find_key.data() + common, find_key.size() - common);
+                    next_common = common + suffix_common;
+                    if (suffix_common == next_node->_suffix_len) {
+                        result = (next_common == find_key.size()) ? 0 : -1;
+                    } else if (next_common == find_key.size()) {
+                        result = 1;
+                    } else {
+                        result = ((unsigned char) next_node->_suffix[suffix_common]
+                                  < (unsigned char) find_key[next_common]) ? -1 : 1;
+                    }
+                }
+                if (result >= 0) {
+                    break;
+                }
+                temp_node = next_node;
+                common = next_common;
+                if (prev_key != nullptr) {
+                    temp_node->decode_key(*prev_key);
+                }
+                next_node = next_node->_fwd_nodes[LOWEST_LEVEL];
+            }
+            if (updated_nodes != nullptr) {
+                updated_nodes[LOWEST_LEVEL] = temp_node;
+            }
+            return (next_node != _tail_node && result == 0) ? next_node : nullptr;
+        }
+
+        // Store the key in the node, front coded against prev_key for level 0 nodes
+        static void encode_key(PrefixNode<M> *node, const std::string &prev_key, const std::string &key) {
+            size_t shared = 0;
+            if (node->_level_node == LOWEST_LEVEL) {
+                shared = common_prefix(prev_key.data(), prev_key.size(), key.data(), key.size());
+            }
+            node->set_key(shared, key.data() + shared, key.size() - shared);
+        }
+
+        // Re-encode the level 0 successor whose previous key changes from old_prev_key to new_prev_key
+        void reencode_successor(PrefixNode<M> *node, const std::string &old_prev_key, const std::string &new_prev_key) {
+            if (node == _tail_node || node->_level_node != LOWEST_LEVEL) {
+                return;
+            }
+            std::string key = old_prev_key;
+            node->decode_key(key);
+            encode_key(node, new_prev_key, key);
+        }
+
+        void init_members() {
+            _num_of_elements = 0;
+            _map_level = 0;
+            _key_bytes = 0;
+            _tower_slots = 0;
+            _rand_level_gen = new RandomLevelGenerator(STRING_MAP_PROB, MAX_NODE_LEVEL);
+            _head_node = new PrefixNode<M>(MAX_NODE_LEVEL);
+            _tail_node = new PrefixNode<M>(MAX_NODE_LEVEL);
+            _head_node->_fwd_nodes[LOWEST_LEVEL] = _tail_node;
+            _head_node->_prev_node = nullptr;
+            _tail_node->_fwd_nodes[LOWEST_LEVEL] = nullptr;
+            _tail_node->_prev_node = _head_node;
+        }
+
+        void destroy_members() {
+            PrefixNode<M> *next_node = nullptr, *head_node = _head_node;
+            while (head_node != nullptr) {
+                next_node = head_node->_fwd_nodes[LOWEST_LEVEL];
+                delete head_node;
+                head_node = next_node;
+            }
+            delete _rand_level_gen;
+        }
+
+        // Keys arrive in order, so every insert is a short descent to the end
+        void insert_all(const StringMap &existing_map) {
+            for (ConstIterator iter = existing_map.begin(); iter != existing_map.end(); ++iter) {
+                insert(std::make_pair(iter.key(), iter.value()));
+            }
+        }
+
+        size_t _num_of_elements;    // Represents number of elements in Map
+        size_t _key_bytes;          // Represents number of key characters stored in suffixes
+        size_t _tower_slots;        // Represents number of forward pointer slots held by element nodes
+        int _map_level;             // Represents maximum node level present in the Map
+        PrefixNode<M> *_head_node;
+        PrefixNode<M> *_tail_node;
+        RandomLevelGenerator *_rand_level_gen;
+    };
+
+    /*
+     * Function to implement insert a new pair into String Map
+     */
+    template<typename M>
+    std::pair<typename StringMap<M>::Iterator, bool> StringMap<M>::insert(const ValueType &new_pair) {
+        PrefixNode<M> *updated_nodes[MAX_NODE_LEVEL + 1];
+        std::string prev_key;
+        const std::string &new_key = new_pair.first;
+        PrefixNode<M> *found_node = locate(new_key, updated_nodes, &prev_key);
+
+        // Handling condition of duplicate keys
+        if (found_node != nullptr) {
+            return std::make_pair(Iterator{found_node, _tail_node, new_key}, false);
+        }
+
+        int new_level = _rand_level_gen->generate_random_level();
+        if (new_level > _map_level) {
+            for (int i = _map_level + 1; i <= new_level; ++i) {
+                updated_nodes[i] = _head_node;
+            }
+            _map_level = new_level;
+        }
+
+        PrefixNode<M> *new_node = new PrefixNode<M>(new_level, new_pair.second);
+        encode_key(new_node, prev_key, new_key);
+        for (int i = 0; i <= new_level; ++i) {
+            new_node->_fwd_nodes[i] = updated_nodes[i]->_fwd_nodes[i];
+            updated_nodes[i]->_fwd_nodes[i] = new_node;
+        }
+
+        // Logic to manage previous pointer
+        PrefixNode<M> *next_node = new_node->_fwd_nodes[LOWEST_LEVEL];
+        new_node->_prev_node = updated_nodes[LOWEST_LEVEL];
+        next_node->_prev_node = new_node;
+
+        // Successor was coded against the previous key, now it follows the new key
+        _key_bytes -= (next_node != _tail_node) ? next_node->_suffix_len : 0;
+        reencode_successor(next_node, prev_key, new_key);
+        _key_bytes += (next_node != _tail_node) ? next_node->_suffix_len : 0;
+        _key_bytes += new_node->_suffix_len;
+        _tower_slots += new_level + 1;
+        ++_num_of_elements;
+        return std::make_pair(Iterator{new_node, _tail_node, new_key}, true);
+    }
+
+    /*
+     * Function to erase node with the specified Key from the String Map
+     * Otherwise throws exception std::out_of_range
+     */
+    template<typename M>
+    void StringMap<M>::erase(const std::string &erase_key) {
+        PrefixNode<M> *updated_nodes[MAX_NODE_LEVEL + 1];
+        std::string prev_key;
+        PrefixNode<M> *temp_node = locate(erase_key, updated_nodes, &prev_key);
+        if (temp_node == nullptr) {
+            throw std::out_of_range("Erase Error ---> Key not found!!");
+        }
+
+        // Redirect forward node pointers from using deleting node
+        for (int lvl = 0; lvl <= _map_level && updated_nodes[lvl]->_fwd_nodes[lvl] == temp_node; ++lvl) {
+            updated_nodes[lvl]->_fwd_nodes[lvl] = temp_node->_fwd_nodes[lvl];
+        }
+        PrefixNode<M> *next_node = temp_node->_fwd_nodes[LOWEST_LEVEL];
+        next_node->_prev_node = temp_node->_prev_node;
+
+        // Successor was coded against the erased key, now it follows the previous key
+        _key_bytes -= (next_node != _tail_node) ? next_node->_suffix_len : 0;
+        reencode_successor(next_node, erase_key, prev_key);
+        _key_bytes += (next_node != _tail_node) ? next_node->_suffix_len : 0;
+        _key_bytes -= temp_node->_suffix_len;
+        _tower_slots -= temp_node->_level_node + 1;
+        delete temp_node;
+
+        // Update modified level of Map (upper level lists end with nullptr)
+        while (_map_level > 0 && _head_node->_fwd_nodes[_map_level] == nullptr) {
+            --_map_level;
+        }
+        --_num_of_elements;
+    }
+
+    /*
+     * Function to report memory used by the String Map
+     */
+    template<typename M>
+    MapMemoryUsage StringMap<M>::memory_usage() const {
+        MapMemoryUsage usage;
+        usage.node_bytes = _num_of_elements * sizeof(PrefixNode<M>);
+        usage.tower_bytes = _tower_slots * sizeof(PrefixNode<M> *);
+        usage.value_bytes = _key_bytes;
+        usage.overhead_bytes = sizeof(StringMap<M>) + sizeof(RandomLevelGenerator)
+                               + 2 * (sizeof(PrefixNode<M>) + (MAX_NODE_LEVEL + 1) * sizeof(PrefixNode<M> *));
+        usage.total_bytes = usage.node_bytes + usage.tower_bytes + usage.value_bytes + usage.overhead_bytes;
+        return usage;
+    }
+}
+
+#endif